@@ -11,16 +11,20 @@ const unsigned long tockPeriod = tickPeriod / (1 << LEDC_RESOLUTION); // microse
 
 volatile uint8_t phase = 0;
 
+// pin map taken from the config on start(), so the ISR never reads the config while it changes
+static uint16_t pinCount = 0;
+static uint16_t pins[MAX_LEDC_MOTORS];
+
 #ifdef ESP8266
 // ESP8266 uses built-in analogWrite()
 // No need for custom ISR implementation
 
 void updateESP8266PWM() {
     // Limit to 8 channels for ESP8266
-    const int maxChannels = min(8, (int)Haptics::Conf::conf.motor_map_ledc_num);
+    const int maxChannels = min(8, (int)pinCount);
     
     for (int motor = 0; motor < maxChannels; ++motor) {
-        uint8_t pin = Haptics::Conf::conf.motor_map_ledc[motor];
+        uint8_t pin = pins[motor];
         // Convert from 8-bit (0-255) to 10-bit (0-1023) for ESP8266 analogWrite
         uint16_t pwmValue = (Haptics::globals.ledcMotorVals[motor] * 1023) / 255;
         analogWrite(pin, pwmValue);
@@ -34,8 +38,8 @@ void IRAM_ATTR pwm_isr()
     uint32_t setMask = 0;   // pins to drive HIGH this sub‑cycle
     uint32_t clrMask = 0;   // pins to drive LOW  this sub‑cycle
 
-    for (int motor = 0; motor < Haptics::Conf::conf.motor_map_ledc_num; ++motor) {
-        uint32_t bit = 1UL << Haptics::Conf::conf.motor_map_ledc[motor];
+    for (int motor = 0; motor < pinCount; ++motor) {
+        uint32_t bit = 1UL << pins[motor];
         if (Haptics::globals.ledcMotorVals[motor] > phase) setMask |= bit;
         else clrMask |= bit;
     }
@@ -47,8 +51,11 @@ void IRAM_ATTR pwm_isr()
 }
 #endif
 
-int start(Haptics::Conf::Config *conf) {
-    if (Haptics::Conf::conf.motor_map_ledc_num != 0) {
+int start(const Haptics::Conf::OutputConfig *conf) {
+    pinCount = 0; // the ISR skips every pin while the map is copied
+    memcpy(pins, conf->motor_map_ledc, sizeof(pins));
+    pinCount = conf->motor_map_ledc_num;
+    if (conf->motor_map_ledc_num != 0) {
         // Update pins and declare pinmodes
 #ifdef ESP8266
         // Limit to 8 channels for ESP8266
@@ -91,7 +98,7 @@ void tick() {
 
 inline int setChannel(const uint8_t channel, const uint16_t duty) {
     // Limit to 8 channels for ESP8266
-    if (channel >= 8 || channel >= Haptics::Conf::conf.motor_map_ledc_num) {
+    if (channel >= 8 || channel >= pinCount) {
         return -1;
     }
     
@@ -99,7 +106,7 @@ inline int setChannel(const uint8_t channel, const uint16_t duty) {
     Haptics::globals.ledcMotorVals[channel] = duty >> 8; // Convert 16-bit to 8-bit
     
     // Update PWM immediately for ESP8266
-    uint8_t pin = Haptics::Conf::conf.motor_map_ledc[channel];
+    uint8_t pin = pins[channel];
     uint16_t pwmValue = (Haptics::globals.ledcMotorVals[channel] * 1023) / 255;
     analogWrite(pin, pwmValue);
     
@@ -107,7 +114,7 @@ inline int setChannel(const uint8_t channel, const uint16_t duty) {
 }
 
 int setAllTo(const uint16_t duty) {
-    const int maxChannels = min(8, (int)Haptics::Conf::conf.motor_map_ledc_num);
+    const int maxChannels = min(8, (int)pinCount);
     for (int i = 0; i < maxChannels; i++) {
         setChannel(i, duty);
     }
@@ -118,7 +125,7 @@ int setAllTo(const uint16_t duty) {
 inline void tick(); // esp32's have timer shenanigans
 
 inline int setChannel(const uint8_t channel, const uint16_t duty) {
-    if (channel >= Haptics::Conf::conf.motor_map_ledc_num) {
+    if (channel >= pinCount) {
         return -1;
     }
     Haptics::globals.ledcMotorVals[channel] = duty >> 8; // Convert 16-bit to 8-bit
@@ -126,7 +133,7 @@ inline int setChannel(const uint8_t channel, const uint16_t duty) {
 }
 
 int setAllTo(const uint16_t duty) {
-    for (int i = 0; i < Haptics::Conf::conf.motor_map_ledc_num; i++) {
+    for (int i = 0; i < pinCount; i++) {
         setChannel(i, duty);
     }
     return 0;
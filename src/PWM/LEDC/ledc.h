@@ -15,7 +15,7 @@ namespace LEDC {
     void tick();
     inline int setChannel(const uint8_t channel, const uint16_t duty);
     int setAllTo(const uint16_t duty);
-    int start(Haptics::Conf::Config *conf);
+    int start(const Haptics::Conf::OutputConfig *conf);
 } // namespace LEDC
 } // namespace Haptics
 
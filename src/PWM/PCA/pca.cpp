@@ -60,7 +60,7 @@ void start(Haptics::Conf::Config *conf) {
 }
 
 /// @brief Sets PCA motors to the values from the global variables
-void setPcaDuty(Globals *globals, Haptics::Conf::Config *conf) {
+void setPcaDuty(Globals *globals, const Haptics::Conf::OutputConfig *conf) {
     for(uint8_t i = 0; i < 16; i++) {
         const uint16_t value = globals->pcaMotorVals[i];
         const uint16_t value2 = globals->pcaMotorVals[i+16];
@@ -17,7 +17,7 @@ namespace PCA {
 
     void start(Haptics::Conf::Config *conf);
     void setPCAMotorDuty(uint8_t motorIndex, uint16_t dutyCycle);
-    void setPcaDuty(Globals *globals, Haptics::Conf::Config *conf);
+    void setPcaDuty(Globals *globals, const Haptics::Conf::OutputConfig *conf);
     void setAllPcaDuty(uint16_t duty, Haptics::Conf::Config *conf);
 } // namespace PCA
 } // namespace Haptics
@@ -4,13 +4,131 @@
 
 #include "config.h"  // has Config and defaultConfig
 #include "config_parser.h"
+#include "crc32.h"
 #include "logging/Logger.h"
 
 namespace Haptics {
 namespace Conf {
     Logging::Logger logger("Config");
 
+    /// Header of `/config.bin`, a raw copy of `Config` written next to `/config.json` on every save.
+    /// Boot copies it straight into `conf` when it still matches this firmware and the JSON next
+    /// to it, JSON is only parsed (and migrated) when it doesn't.
+    struct ConfigSnapshotHeader {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t reserved;
+        /// @brief `sizeof(Config)`, catches fields added without a version bump.
+        uint32_t size;
+        /// @brief Checksum of the field descriptors, catches fields moved or retyped at the same size.
+        uint32_t layout;
+        /// @brief Size and checksum of `/config.json` when the snapshot was taken, so a JSON
+        /// edited by hand, uploaded with a filesystem image or written by older firmware wins.
+        uint32_t jsonSize;
+        uint32_t jsonCrc;
+        /// @brief Checksum of the `Config` bytes that follow.
+        uint32_t crc;
+    };
+
+    static const uint32_t SNAPSHOT_MAGIC = 0x48434647; // "HCFG"
+
+    /// @brief Checksum of every field's name, offset, type and size.
+    static uint32_t layoutChecksum() {
+        uint32_t crc = 0;
+        for (size_t i = 0; i < configFieldsCount; i++) {
+            const ConfigFieldDescriptor &field = configFields[i];
+            const uint32_t shape[4] = {(uint32_t)field.offset, (uint32_t)field.type, (uint32_t)field.size, (uint32_t)field.subType};
+            crc = crc32((const uint8_t *)field.name, strlen(field.name), crc);
+            crc = crc32((const uint8_t *)shape, sizeof(shape), crc);
+        }
+        return crc;
+    }
+
+    /// @brief Size and checksum of `/config.json` as it is on flash.
+    /// @return false if there is no JSON to check against
+    static bool jsonChecksum(uint32_t &size, uint32_t &crc) {
+        File file = LittleFS.open("/config.json", "r");
+        if (!file)
+            return false;
+
+        uint8_t chunk[128];
+        size = 0;
+        crc = 0;
+        while (file.available()) {
+            const size_t read = file.read(chunk, sizeof(chunk));
+            if (read == 0)
+                break;
+            crc = crc32(chunk, read, crc);
+            size += read;
+        }
+        file.close();
+        return true;
+    }
+
+    /// @brief Loads `/config.bin` into `conf` if it is intact and matches this firmware and `/config.json`.
+    /// @return false if JSON has to be parsed instead, a rejected snapshot leaves the defaults in `conf`
+    static bool loadSnapshot() {
+        File file = LittleFS.open("/config.bin", "r");
+        if (!file)
+            return false;
+
+        // read straight into `conf`, no second copy of a whole config
+        ConfigSnapshotHeader header;
+        uint32_t jsonSize, jsonCrc;
+        const bool complete = file.read((uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+                              file.read((uint8_t *)&conf, sizeof(Config)) == sizeof(Config);
+        file.close();
+
+        const char *problem = nullptr;
+        if (!complete || header.magic != SNAPSHOT_MAGIC || header.version != CONFIG_VERSION ||
+            header.size != sizeof(Config) || header.layout != layoutChecksum())
+            problem = "is from another firmware";
+        else if (!jsonChecksum(jsonSize, jsonCrc) || jsonSize != header.jsonSize || jsonCrc != header.jsonCrc)
+            problem = "doesn't match config.json";
+        else if (crc32((const uint8_t *)&conf, sizeof(Config)) != header.crc)
+            problem = "is corrupt";
+
+        if (problem) {
+            logger.warn("Config snapshot %s, loading JSON", problem);
+            memcpy(&conf, &defaultConfig, sizeof(Config));
+            return false;
+        }
+        return true;
+    }
+
+    /// @brief Writes `conf` to `/config.bin` for the next boot, call after `/config.json` was written.
+    static void saveSnapshot() {
+        ConfigSnapshotHeader header = {
+            SNAPSHOT_MAGIC, CONFIG_VERSION, 0, sizeof(Config), layoutChecksum(), 0, 0,
+            crc32((const uint8_t *)&conf, sizeof(Config)),
+        };
+        if (!jsonChecksum(header.jsonSize, header.jsonCrc)) {
+            LittleFS.remove("/config.bin");
+            return;
+        }
+
+        File file = LittleFS.open("/config.bin", "w");
+        if (!file) {
+            logger.error("Failed to open config snapshot for writing.");
+            return;
+        }
+        const bool written = file.write((const uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+                             file.write((const uint8_t *)&conf, sizeof(Config)) == sizeof(Config);
+        file.close();
+        // a half written snapshot fails its CRC anyway, but don't leave it around
+        if (!written) {
+            logger.error("Failed to write config snapshot.");
+            LittleFS.remove("/config.bin");
+        }
+    }
+
     void loadConfig() {
+        // fast path, no JSON parsing or printing
+        if (loadSnapshot()) {
+            logger.debug("Loaded config snapshot.");
+            return;
+        }
+
         // Check if the config file exists.
         if (!LittleFS.exists("/config.json")) {
             logger.debug("Config file not found. Creating default config.");
@@ -106,6 +224,9 @@ namespace Conf {
         if (fileVersion < defaultConfig.config_version || defaultConfig.config_version == 0) {
             logger.debug("Config version outdated. Merging new defaults and updating file.");
             saveConfig();
+        } else {
+            // the snapshot was missing or stale, next boot can skip all of this
+            saveSnapshot();
         }
 
         logger.debug("Loaded config:");
@@ -167,6 +288,7 @@ namespace Conf {
         if (configFile) {
             serializeJson(doc, configFile);
             configFile.close();
+            saveSnapshot();
             logger.debug("Configuration saved.");
             serializeJsonPretty(doc, Serial);
             Serial.println();
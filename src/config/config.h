@@ -33,6 +33,20 @@ namespace Conf {
         int64_t bump_time_us;
         /// @brief  Motor values below this threshold will activate a bump, if the previous value was zero.
         uint16_t bump_start_threshold; 
+        /// @brief Ramp motors between received frames instead of stepping, 0 = off.
+        uint8_t interp_enabled;
+        /// @brief Longest ramp in microseconds, slower host rates step once this elapses.
+        uint32_t interp_max_ramp_us;
+        /// @brief Listen for motor frames on the shared multicast stream, 0 = off.
+        uint8_t stream_enabled;
+        /// @brief Index of this board's first motor within the shared stream's frames.
+        uint16_t stream_offset;
+        /// @brief Milliseconds without a frame before the motors start fading, short gaps hold the last values.
+        uint16_t failsafe_hold_ms;
+        /// @brief Milliseconds the fade from the held values to zero takes, 0 = stop at once.
+        uint16_t failsafe_fade_ms;
+        /// @brief Each motor's groups as a bitmask (bit n = group n), indexed like `allMotorVals`: ledc motors first, then i2c.
+        uint16_t motor_groups[MAX_MOTORS];
         /// @brief The current configuration version.
         uint16_t config_version;
     }; 
@@ -55,6 +69,13 @@ namespace Conf {
     {0},
     10000, // 10ms (May need to be lowered.)
     20000, // ~30%
+    0, // interpolation off
+    33333, // ramp over at most one 30hz frame
+    0, // shared stream off
+    0, // first motor in the shared stream
+    100, // hold through ~3 dropped 30hz frames
+    400, // then fade out
+    {0}, // no motor in any group
     CONFIG_VERSION
     };
 
@@ -65,6 +86,35 @@ namespace Conf {
 
     inline Config conf;
 
+    /// The part of the config the output path reads. It works from its own copy, handed over
+    /// whenever a command may have changed `conf`, so it never reads `conf` mid-write.
+    struct OutputConfig {
+        uint16_t motor_map_i2c_num;
+        uint16_t motor_map_i2c[MAX_I2C_MOTORS];
+        uint16_t motor_map_ledc_num;
+        uint16_t motor_map_ledc[MAX_LEDC_MOTORS];
+        int64_t bump_time_us;
+        uint16_t bump_start_threshold;
+        uint8_t interp_enabled;
+        uint32_t interp_max_ramp_us;
+        uint16_t failsafe_hold_ms;
+        uint16_t failsafe_fade_ms;
+    };
+
+    /// @brief Copies the fields the output path reads out of `from`.
+    inline void copyOutputConfig(const Config &from, OutputConfig &to) {
+        to.motor_map_i2c_num = from.motor_map_i2c_num;
+        memcpy(to.motor_map_i2c, from.motor_map_i2c, sizeof(to.motor_map_i2c));
+        to.motor_map_ledc_num = from.motor_map_ledc_num;
+        memcpy(to.motor_map_ledc, from.motor_map_ledc, sizeof(to.motor_map_ledc));
+        to.bump_time_us = from.bump_time_us;
+        to.bump_start_threshold = from.bump_start_threshold;
+        to.interp_enabled = from.interp_enabled;
+        to.interp_max_ramp_us = from.interp_max_ramp_us;
+        to.failsafe_hold_ms = from.failsafe_hold_ms;
+        to.failsafe_fade_ms = from.failsafe_fade_ms;
+    }
+
     // Supported field types.
     enum ConfigFieldType {
         CONFIG_TYPE_UINT8,
@@ -107,6 +157,13 @@ namespace Conf {
         CONFIG_FIELD_ARRAY(motor_map_ledc, CONFIG_TYPE_UINT16, MAX_LEDC_MOTORS),
         CONFIG_FIELD(bump_time_us,  CONFIG_TYPE_INT64, 0),
         CONFIG_FIELD(bump_start_threshold, CONFIG_TYPE_UINT16, 0),
+        CONFIG_FIELD(interp_enabled, CONFIG_TYPE_UINT8, 0),
+        CONFIG_FIELD(interp_max_ramp_us, CONFIG_TYPE_UINT32, 0),
+        CONFIG_FIELD(stream_enabled, CONFIG_TYPE_UINT8, 0),
+        CONFIG_FIELD(stream_offset, CONFIG_TYPE_UINT16, 0),
+        CONFIG_FIELD(failsafe_hold_ms, CONFIG_TYPE_UINT16, 0),
+        CONFIG_FIELD(failsafe_fade_ms, CONFIG_TYPE_UINT16, 0),
+        CONFIG_FIELD_ARRAY(motor_groups, CONFIG_TYPE_UINT16, MAX_MOTORS),
         CONFIG_FIELD(config_version, CONFIG_TYPE_UINT16, 0)
     };
     static const size_t configFieldsCount = sizeof(configFields) / sizeof(configFields[0]);
@@ -1,5 +1,10 @@
 #include "config_parser.h"
 #include "config.h"
+#include "response_writer.h"
+#include "upload.h"
+#include "globals.h"
+#include "pipeline/pipeline.h"
+#include "wifi/callbacks.h"
 #include <ArduinoJson.h>
 #include "logging/Logger.h"
 
@@ -53,7 +58,8 @@ namespace Parser {
             } else {
                 // parse the provided JSON string.
                 //logger.debug("Updating config from JSON");
-                StaticJsonDocument<JSON_SIZE> doc;
+                // heap allocated, a full config document is too big for the loop stack
+                DynamicJsonDocument doc(JSON_SIZE);
                 DeserializationError error = deserializeJson(doc, value);
                 if (error) {
                     //logger.error("Failed to parse config JSON: %s", error.c_str());
@@ -210,138 +216,122 @@ namespace Parser {
         }
     }
 
+    /// @brief Writes a single value of a numeric field.
+    static void writeScalar(const void* ptr, ConfigFieldType type, ResponseWriter &out) {
+        switch (type) {
+            case CONFIG_TYPE_UINT8:
+                out.writeNumber(*(const uint8_t*)ptr);
+                break;
+            case CONFIG_TYPE_UINT16:
+                out.writeNumber(*(const uint16_t*)ptr);
+                break;
+            case CONFIG_TYPE_UINT32:
+                out.writeNumber(*(const uint32_t*)ptr);
+                break;
+            case CONFIG_TYPE_FLOAT:
+                out.writeFloat(*(const float*)ptr);
+                break;
+            case CONFIG_TYPE_INT64:
+                out.writeNumber(*(const int64_t*)ptr);
+                break;
+            default:
+                out.write("\"?\"");
+                break;
+        }
+    }
+
     /// @brief Handles all commands under the GET keyword
     /// @param key Which config key to get
     /// @param value Currently unused
-    /// @return Feedback to return
-    String handleGet(const String &key, const String &value) {
-        // If "ALL", build a JSON string.
+    /// @param out Where the response is written
+    void handleGet(const String &key, const String &value, ResponseWriter &out) {
+        // If "ALL", stream a JSON object field by field.
         if (key.equalsIgnoreCase("ALL")) {
-            String json = "{";
+            out.write('{');
             for (size_t i = 0; i < configFieldsCount; i++) {
                 const ConfigFieldDescriptor& field = configFields[i];
                 void* ptr = getFieldPtr(field);
-                String fieldVal;
-                bool outputQuotes = false; // controls whether to wrap fieldVal in quotes
-    
+
+                out.write('"');
+                out.write(field.name);
+                out.write("\":");
                 switch (field.type) {
                     case CONFIG_TYPE_STRING:
-                        fieldVal = String((char*)ptr);
-                        outputQuotes = true;
-                        break;
-                    case CONFIG_TYPE_UINT8:
-                        fieldVal = String(*(uint8_t*)ptr);
-                        break;
-                    case CONFIG_TYPE_UINT16:
-                        fieldVal = String(*(uint16_t*)ptr);
-                        break;
-                    case CONFIG_TYPE_UINT32:
-                        fieldVal = String(*(uint32_t*)ptr);
-                        break;
-                    case CONFIG_TYPE_FLOAT:
-                        fieldVal = String(*(float*)ptr);
-                        break;
-                    case CONFIG_TYPE_INT64: 
-                        fieldVal = String(*(int64_t*)ptr);
+                        out.write('"');
+                        out.write((const char*)ptr);
+                        out.write('"');
                         break;
                     case CONFIG_TYPE_ARRAY:
-                        fieldVal = getArrayFieldValue(ptr, field);
-                        // Only wrap array elements in quotes if the array's subtype is string.
-                        if (field.subType == CONFIG_TYPE_STRING) {
-                            outputQuotes = true;
-                        }
+                        writeArrayFieldValue(ptr, field, out);
+                        break;
+                    default:
+                        writeScalar(ptr, field.type, out);
                         break;
-                }
-
-                json += "\"" + String(field.name) + "\":";
-                if (outputQuotes) {
-                    json += "\"" + fieldVal + "\"";
-                } else {
-                    json += fieldVal;
                 }
                 if (i < configFieldsCount - 1)
-                    json += ",";
-                }
-            json += "}";
-            return json;
+                    out.write(',');
+            }
+            out.write('}');
+            return;
         }
 
         // Otherwise, locate the descriptor for the given key.
-        logger.debug("This that: %s", key);
         const ConfigFieldDescriptor* field = getConfigFieldDescriptor(key);
         if (!field) {
-            return "Error: Unknown config key " + key;
+            out.write("Error: Unknown config key " + key);
+            return;
         }
 
-        String result = ""; // Throws fit if not out here
         void* ptr = getFieldPtr(*field);
         switch (field->type) {
             case CONFIG_TYPE_STRING:
-                return String((char*)ptr);
-            case CONFIG_TYPE_UINT8:
-                return String(*(uint8_t*)ptr);
-            case CONFIG_TYPE_UINT16:
-                return String(*(uint16_t*)ptr);
-            case CONFIG_TYPE_UINT32:
-                return String(*(uint32_t*)ptr);
-            case CONFIG_TYPE_FLOAT:
-                return String(*(float*)ptr);
+                out.write((const char*)ptr);
+                break;
             case CONFIG_TYPE_ARRAY: {
-                uint16_t* arr = (uint16_t*)((uint8_t*)&conf + field->offset);
+                // bare CSV, the same format SET takes
+                const uint16_t* arr = (const uint16_t*)ptr;
                 for (size_t i = 0; i < field->size; i++) {
-                    result += String(arr[i]);
+                    out.writeNumber(arr[i]);
                     if (i < field->size - 1)
-                        result += ",";
+                        out.write(',');
                 }
-                return result;
+                break;
             }
-            case CONFIG_TYPE_INT64:
-                return String(*(int64_t*)ptr);
             default:
-                return "Error: Unsupported type";
+                writeScalar(ptr, field->type, out);
+                break;
         }
     }
 
-    String getArrayFieldValue(void* ptr, const ConfigFieldDescriptor &field) {
-        String result = "[";
+    void writeArrayFieldValue(const void* ptr, const ConfigFieldDescriptor &field, ResponseWriter &out) {
+        out.write('[');
         // Assume field.size is the number of elements in the array.
         for (size_t j = 0; j < field.size; j++) {
             if (j > 0) {
-                result += ",";
+                out.write(',');
             }
             switch (field.subType) {
-                case CONFIG_TYPE_UINT8: {
-                    uint8_t* arr = (uint8_t*)ptr;
-                    result += String(arr[j]);
+                case CONFIG_TYPE_UINT8:
+                    writeScalar((const uint8_t*)ptr + j, field.subType, out);
                     break;
-                }
-                case CONFIG_TYPE_UINT16: {
-                    uint16_t* arr = (uint16_t*)ptr;
-                    result += String(arr[j]);
+                case CONFIG_TYPE_UINT16:
+                    writeScalar((const uint16_t*)ptr + j, field.subType, out);
                     break;
-                }
-                case CONFIG_TYPE_UINT32: {
-                    uint32_t* arr = (uint32_t*)ptr;
-                    result += String(arr[j]);
+                case CONFIG_TYPE_UINT32:
+                    writeScalar((const uint32_t*)ptr + j, field.subType, out);
                     break;
-                }
-                case CONFIG_TYPE_FLOAT: {
-                    float* arr = (float*)ptr;
-                    result += String(arr[j]);
+                case CONFIG_TYPE_FLOAT:
+                    writeScalar((const float*)ptr + j, field.subType, out);
                     break;
-                }
-                case CONFIG_TYPE_INT64: {
-                    int64_t* arr = (int64_t*)ptr;
-                    result += String(arr[j]);
+                case CONFIG_TYPE_INT64:
+                    writeScalar((const int64_t*)ptr + j, field.subType, out);
                     break;
-                }
                 default:
-                    result += "\"?\"";
+                    out.write("\"?\"");
                     break;
             }
         }
-        result += "]";
-        return result;
+        out.write(']');
     }
 
     // Helper function to set an array field from a CSV string.
@@ -436,10 +426,125 @@ namespace Parser {
         #endif
     }
 
-    /// @brief Parses input and manages the configuration accordingly
-    /// @param input the input string to be processed for a command
-    /// @return The return message
-    String parseInput(const String &input) {
+    void getFrameStats(String &out) {
+        char buf[256];
+        Frames::formatStats(Wireless::frameStats(), buf, sizeof(buf));
+        out = buf;
+    }
+
+    void getLatency(String &out) {
+        char buf[320];
+        Frames::formatLatency(Pipeline::latency(), buf, sizeof(buf));
+        out = buf;
+    }
+
+    void getSync(String &out) {
+        const int64_t now = nowMicros();
+        char buf[128];
+        snprintf(buf, sizeof(buf), "{\"synced\":%s,\"offset_us\":%lu,\"error_us\":%lu,\"drift_ppm\":%ld,\"samples\":%lu}",
+                 clockSync.synced(now) ? "true" : "false", (unsigned long)clockSync.offsetUs(now),
+                 (unsigned long)clockSync.errorUs(now), (long)clockSync.driftPpm(), (unsigned long)clockSync.samples());
+        out = buf;
+    }
+
+    /// @brief Answers a GET, including the status keys that aren't config fields.
+    static void handleGetAny(const String &key, const String &value, ResponseWriter &out) {
+        String feedback;
+        if (key.equalsIgnoreCase("PLATFORM")) {
+            getPlatform(feedback);
+        } else if (key.equalsIgnoreCase("FRAME_STATS")) {
+            getFrameStats(feedback);
+        } else if (key.equalsIgnoreCase("LATENCY")) {
+            getLatency(feedback);
+        } else if (key.equalsIgnoreCase("SYNC")) {
+            getSync(feedback);
+        } else {
+            handleGet(key, value, out);
+            return;
+        }
+        out.write(feedback);
+    }
+
+    /// @brief Runs a JSON array of SET/GET commands as one transaction.
+    /// Any failing SET rolls the whole config back, `SAVE` persists once at the end.
+    /// @param mode `SAVE` or `APPLY`
+    /// @param value the JSON array of command strings
+    /// @param out receives `{"results":[...],"ok":true}`, or `"ok":false,"failed":<index>`
+    static void handleBatch(const String &mode, const String &value, ResponseWriter &out) {
+        const bool save = mode == "SAVE";
+        if (!save && mode != "APPLY") {
+            out.write("Error: BATCH takes SAVE or APPLY");
+            return;
+        }
+
+        // the strings are copied out of `value`, so it all has to fit
+        DynamicJsonDocument doc(JSON_ARRAY_SIZE(MAX_BATCH_COMMANDS) + value.length() + 1);
+        const DeserializationError error = deserializeJson(doc, value);
+        JsonArray commands = doc.as<JsonArray>();
+        if (error || commands.isNull()) {
+            out.write("Error: BATCH expects a JSON array of commands");
+            return;
+        }
+        if (commands.size() > MAX_BATCH_COMMANDS) {
+            out.write("Error: BATCH is limited to " + String(MAX_BATCH_COMMANDS) + " commands");
+            return;
+        }
+
+        // rollback copy, only held for the batch, a whole config is too big for the loop stack
+        Config *snapshot = (Config *)malloc(sizeof(Config));
+        if (!snapshot) {
+            out.write("Error: BATCH out of memory");
+            return;
+        }
+        memcpy(snapshot, &conf, sizeof(Config));
+
+        int failed = -1;
+        size_t index = 0;
+        out.write("{\"results\":[");
+        for (JsonVariant entry : commands) {
+            String command, key, argument;
+            cutInput(entry.as<String>(), command, key, argument);
+            if (index > 0)
+                out.write(',');
+            out.write('"');
+            out.escapeJson(true);
+
+            if (command == "SET") {
+                const String feedback = handleSet(key, argument);
+                out.write(feedback);
+                if (feedback.startsWith("Error"))
+                    failed = (int)index;
+            } else if (command == "GET") {
+                handleGetAny(key, argument, out);
+            } else {
+                out.write("Error: only SET and GET can be batched");
+                failed = (int)index;
+            }
+
+            out.escapeJson(false);
+            out.write('"');
+            if (failed >= 0)
+                break;
+            index++;
+        }
+        out.write(']');
+
+        if (failed < 0 && save)
+            saveConfig();
+        if (failed >= 0)
+            memcpy(&conf, snapshot, sizeof(Config));
+        free(snapshot);
+
+        if (failed >= 0) {
+            out.write(",\"ok\":false,\"failed\":");
+            out.writeNumber(failed);
+            out.write('}');
+            return;
+        }
+        out.write(",\"ok\":true}");
+    }
+
+    void execute(const String &input, ResponseWriter &out) {
         // get tokens
         String command, key, value, feedback;
         cutInput(input, command, key, value);
@@ -449,18 +554,27 @@ namespace Parser {
             feedback = handleSet(key, value);
             saveConfig();
         } else if (command == "GET") {
-            if (key.equalsIgnoreCase("PLATFORM")) {
-                getPlatform(feedback);
-                return feedback;
-            }
-            feedback = handleGet(key, value);
+            handleGetAny(key, value, out);
+            logger.debug("GET %s peak heap use: %lu bytes", key.c_str(), (unsigned long)out.peakHeapUse());
+            return;
+        } else if (command == "BATCH") {
+            handleBatch(key, value, out);
+            return;
+        } else if (command == "UPLOAD") {
+            Upload::handle(key, value, out);
+            return;
         } else if (command == "REBOOT" || command == "RESTART") {
             ESP.restart();
         } else {
             feedback = "Unknown command: "+ input;
         }
 
-        return feedback;
+        out.write(feedback);
+    }
+
+    void parseInput(const String &input, ResponseWriter &out) {
+        execute(input, out);
+        out.finish();
     }
 } /// Parser
 }
@@ -4,16 +4,20 @@
 #define CONFIG_PARSER_H
 
 #include "config.h"
+#include "response_writer.h"
 
 namespace Haptics {
 namespace Conf { 
 namespace Parser {
-    /// @brief Takes an input string containing a command and returns the response to be retransmitted
+    /// @brief Takes an input string containing a command and writes the response to be retransmitted
     /// @param input The string that should be parsed
-    /// @return The response or feedback containing either confirmation or the requested data
-    String parseInput(const String &input);
+    /// @param out Receives the response or feedback containing either confirmation or the requested data
+    void parseInput(const String &input, ResponseWriter &out);
 
-    String getArrayFieldValue(void* ptr, const ConfigFieldDescriptor &field);
+    /// @brief Runs a command like `parseInput`, but leaves `out` open so the caller can keep writing.
+    void execute(const String &input, ResponseWriter &out);
+
+    void writeArrayFieldValue(const void* ptr, const ConfigFieldDescriptor &field, ResponseWriter &out);
     bool setArrayFieldValue(void* ptr, const ConfigFieldDescriptor &field, const String& input);
 }
 }
@@ -0,0 +1,26 @@
+#include "crc32.h"
+
+namespace Haptics {
+namespace Conf {
+
+    // one nibble at a time, 64 bytes of table instead of 1 KB
+    static const uint32_t nibbleTable[16] = {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac,
+        0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+        0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+    };
+
+    uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc)
+    {
+        crc = ~crc;
+        for (size_t i = 0; i < len; i++)
+        {
+            crc = nibbleTable[(crc ^ data[i]) & 0x0f] ^ (crc >> 4);
+            crc = nibbleTable[(crc ^ (data[i] >> 4)) & 0x0f] ^ (crc >> 4);
+        }
+        return ~crc;
+    }
+
+} // namespace Conf
+} // namespace Haptics
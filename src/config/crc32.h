@@ -0,0 +1,17 @@
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Haptics {
+namespace Conf {
+
+    /// @brief Standard CRC-32 (IEEE, the one zlib and Python's `zlib.crc32` use).
+    /// @param crc result of the previous call to continue a running checksum, 0 to start
+    uint32_t crc32(const uint8_t *data, size_t len, uint32_t crc = 0);
+
+} // namespace Conf
+} // namespace Haptics
+
+#endif // CRC32_H
@@ -0,0 +1,116 @@
+#include "response_writer.h"
+
+namespace Haptics {
+namespace Conf {
+
+    ResponseWriter::ResponseWriter(Sink sink, void *context)
+        : sink(sink), context(context)
+    {
+        startFreeHeap = ESP.getFreeHeap();
+        minFreeHeap = startFreeHeap;
+    }
+
+    void ResponseWriter::write(const char *text)
+    {
+        write(text, strlen(text));
+    }
+
+    void ResponseWriter::write(const char *text, size_t len)
+    {
+        if (!escaping)
+        {
+            append(text, len);
+            return;
+        }
+
+        // copy the plain runs in one go, only the characters JSON reserves are split out
+        static const char hex[] = "0123456789abcdef";
+        size_t run = 0;
+        for (size_t i = 0; i < len; i++)
+        {
+            const unsigned char c = (unsigned char)text[i];
+            if (c != '"' && c != '\\' && c >= 0x20)
+                continue;
+            append(text + run, i - run);
+            run = i + 1;
+            if (c == '"' || c == '\\')
+            {
+                const char escaped[2] = {'\\', (char)c};
+                append(escaped, 2);
+            }
+            else if (c == '\n')
+                append("\\n", 2);
+            else if (c == '\r')
+                append("\\r", 2);
+            else if (c == '\t')
+                append("\\t", 2);
+            else
+            {
+                // any other control character, like a stray byte in a device name
+                const char escaped[6] = {'\\', 'u', '0', '0', hex[c >> 4], hex[c & 0xf]};
+                append(escaped, 6);
+            }
+        }
+        append(text + run, len - run);
+    }
+
+    void ResponseWriter::append(const char *text, size_t len)
+    {
+        while (len > 0)
+        {
+            if (length == RESPONSE_CHUNK_SIZE)
+                flush(false);
+
+            const size_t space = RESPONSE_CHUNK_SIZE - length;
+            const size_t part = len < space ? len : space;
+            memcpy(buffer + length, text, part);
+            length += part;
+            text += part;
+            len -= part;
+        }
+    }
+
+    void ResponseWriter::writeNumber(int64_t value)
+    {
+        // digits are produced backwards, 20 covers the sign and every int64
+        char digits[20];
+        size_t count = 0;
+        uint64_t magnitude = value < 0 ? (uint64_t)0 - (uint64_t)value : (uint64_t)value;
+        do
+        {
+            digits[count++] = '0' + magnitude % 10;
+            magnitude /= 10;
+        } while (magnitude > 0);
+        if (value < 0)
+            digits[count++] = '-';
+
+        while (count > 0)
+            write(digits[--count]);
+    }
+
+    void ResponseWriter::writeFloat(float value)
+    {
+        // same two decimals String(float) gives
+        char text[24];
+        dtostrf(value, 1, 2, text);
+        write(text);
+    }
+
+    void ResponseWriter::finish()
+    {
+        flush(true);
+    }
+
+    void ResponseWriter::flush(bool last)
+    {
+        const uint32_t freeHeap = ESP.getFreeHeap();
+        if (freeHeap < minFreeHeap)
+            minFreeHeap = freeHeap;
+
+        buffer[length] = 0;
+        sink(buffer, length, chunkIndex++, last, context);
+        length = 0;
+    }
+
+} // namespace Conf
+} // namespace Haptics
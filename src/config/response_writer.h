@@ -0,0 +1,55 @@
+#ifndef RESPONSE_WRITER_H
+#define RESPONSE_WRITER_H
+
+#include <Arduino.h>
+
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Conf {
+
+    /// Writes a command response into a fixed buffer and hands it to a transport one
+    /// chunk at a time, so long replies like `GET ALL` never exist whole on the heap.
+    class ResponseWriter {
+    public:
+        /// @brief Receives each chunk, null terminated.
+        /// @param index position of the chunk in the response, from 0
+        /// @param last whether this chunk ends the response
+        typedef void (*Sink)(const char *chunk, size_t len, uint16_t index, bool last, void *context);
+
+        ResponseWriter(Sink sink, void *context);
+
+        void write(const char *text);
+        void write(const char *text, size_t len);
+        void write(const String &text) { write(text.c_str(), text.length()); }
+        void write(char c) { write(&c, 1); }
+        void writeNumber(int64_t value);
+        void writeFloat(float value);
+
+        /// @brief While on, `"`, `\` and control characters are escaped so the text can sit inside a JSON string.
+        void escapeJson(bool on) { escaping = on; }
+
+        /// @brief Sends whatever is left as the last chunk, call once at the end.
+        void finish();
+
+        /// @brief Most heap that was in use beyond what was free when the writer was created.
+        uint32_t peakHeapUse() const { return startFreeHeap > minFreeHeap ? startFreeHeap - minFreeHeap : 0; }
+
+    private:
+        void flush(bool last);
+        void append(const char *text, size_t len);
+
+        Sink sink;
+        void *context;
+        char buffer[RESPONSE_CHUNK_SIZE + 1];
+        size_t length = 0;
+        uint16_t chunkIndex = 0;
+        bool escaping = false;
+        uint32_t startFreeHeap;
+        uint32_t minFreeHeap;
+    };
+
+} // namespace Conf
+} // namespace Haptics
+
+#endif // RESPONSE_WRITER_H
@@ -0,0 +1,203 @@
+#include "upload.h"
+#include "crc32.h"
+#include "config_parser.h"
+#include "software_defines.h"
+#include "logging/Logger.h"
+
+namespace Haptics {
+namespace Conf {
+namespace Upload {
+
+    Logging::Logger logger("Upload");
+
+    // the command being assembled, only allocated between BEGIN and COMMIT/ABORT
+    static char *buffer = nullptr;
+    static size_t totalSize = 0;
+    static size_t chunkSize = 0;
+    static uint16_t chunkCount = 0;
+    static uint16_t receivedCount = 0;
+    static uint32_t expectedCrc = 0;
+    static uint64_t receivedChunks = 0; // one bit per chunk
+    static_assert(UPLOAD_MAX_CHUNKS <= 64, "received chunks are tracked in a uint64_t");
+
+    static bool hasChunk(uint16_t index)
+    {
+        return (receivedChunks >> index) & 1;
+    }
+
+    static void release()
+    {
+        free(buffer);
+        buffer = nullptr;
+        chunkCount = 0;
+        receivedCount = 0;
+    }
+
+    static void begin(const String &value, ResponseWriter &out)
+    {
+        release();
+
+        char *end = nullptr;
+        const unsigned long total = strtoul(value.c_str(), &end, 10);
+        const unsigned long size = strtoul(end, &end, 10);
+        // strtoul reads a missing CRC as 0, which no transfer would ever match
+        const char *crcText = end;
+        const unsigned long crc = strtoul(crcText, &end, 16);
+        if (total == 0 || total > UPLOAD_MAX_SIZE || size == 0 || end == crcText)
+        {
+            out.write("Error: UPLOAD BEGIN <total bytes up to " + String(UPLOAD_MAX_SIZE) + "> <chunk size> <crc32 hex>");
+            return;
+        }
+        const unsigned long count = (total + size - 1) / size;
+        if (count > UPLOAD_MAX_CHUNKS)
+        {
+            out.write("Error: UPLOAD is limited to " + String(UPLOAD_MAX_CHUNKS) + " chunks");
+            return;
+        }
+
+        buffer = (char *)malloc(total + 1);
+        if (!buffer)
+        {
+            out.write("Error: UPLOAD out of memory");
+            return;
+        }
+        buffer[total] = 0;
+        totalSize = total;
+        chunkSize = size;
+        chunkCount = count;
+        expectedCrc = crc;
+        receivedChunks = 0;
+
+        out.write("UPLOAD READY ");
+        out.writeNumber(chunkCount);
+    }
+
+    static void chunk(const String &value, ResponseWriter &out)
+    {
+        if (!buffer)
+        {
+            out.write("Error: no UPLOAD in progress");
+            return;
+        }
+
+        const int space = value.indexOf(' ');
+        const long index = value.substring(0, space).toInt();
+        if (space < 0 || index < 0 || index >= chunkCount)
+        {
+            out.write("Error: UPLOAD CHUNK <index 0-" + String(chunkCount - 1) + "> <data>");
+            return;
+        }
+
+        // every chunk is full size except the last one
+        const size_t offset = index * chunkSize;
+        const size_t expected = (size_t)index == chunkCount - 1u ? totalSize - offset : chunkSize;
+        const size_t len = value.length() - space - 1;
+        if (len != expected)
+        {
+            out.write("Error: UPLOAD chunk " + String(index) + " should be " + String(expected) + " bytes");
+            return;
+        }
+
+        memcpy(buffer + offset, value.c_str() + space + 1, len);
+        if (!hasChunk(index))
+        {
+            receivedChunks |= (uint64_t)1 << index;
+            receivedCount++;
+        }
+
+        out.write("UPLOAD ACK ");
+        out.writeNumber(index);
+        out.write(' ');
+        out.writeNumber(receivedCount);
+        out.write('/');
+        out.writeNumber(chunkCount);
+    }
+
+    /// @brief Writes the indexes of the chunks not received yet as CSV.
+    static void writeMissing(ResponseWriter &out)
+    {
+        bool first = true;
+        for (uint16_t i = 0; i < chunkCount; i++)
+        {
+            if (hasChunk(i))
+                continue;
+            if (!first)
+                out.write(',');
+            out.writeNumber(i);
+            first = false;
+        }
+    }
+
+    static void status(ResponseWriter &out)
+    {
+        if (!buffer)
+        {
+            out.write("UPLOAD IDLE");
+            return;
+        }
+        if (receivedCount == chunkCount)
+        {
+            out.write("UPLOAD COMPLETE");
+            return;
+        }
+        out.write("UPLOAD MISSING ");
+        writeMissing(out);
+    }
+
+    static void commit(ResponseWriter &out)
+    {
+        if (!buffer)
+        {
+            out.write("Error: no UPLOAD in progress");
+            return;
+        }
+        if (receivedCount != chunkCount)
+        {
+            out.write("Error: UPLOAD MISSING ");
+            writeMissing(out);
+            return;
+        }
+
+        const uint32_t crc = crc32((const uint8_t *)buffer, totalSize);
+        if (crc != expectedCrc)
+        {
+            // keep the chunks, the host can resend them all and commit again
+            receivedChunks = 0;
+            receivedCount = 0;
+            out.write("Error: UPLOAD crc mismatch, resend all chunks");
+            return;
+        }
+
+        const String command(buffer);
+        release();
+        if (command.substring(0, 6).equalsIgnoreCase("UPLOAD"))
+        {
+            out.write("Error: an UPLOAD can't carry another UPLOAD");
+            return;
+        }
+        logger.debug("Running uploaded command, %u bytes", command.length());
+        Parser::execute(command, out);
+    }
+
+    void handle(const String &action, const String &value, ResponseWriter &out)
+    {
+        if (action == "BEGIN")
+            begin(value, out);
+        else if (action == "CHUNK")
+            chunk(value, out);
+        else if (action == "STATUS")
+            status(out);
+        else if (action == "COMMIT")
+            commit(out);
+        else if (action == "ABORT")
+        {
+            release();
+            out.write("UPLOAD ABORTED");
+        }
+        else
+            out.write("Error: UPLOAD takes BEGIN, CHUNK, STATUS, COMMIT or ABORT");
+    }
+
+} // namespace Upload
+} // namespace Conf
+} // namespace Haptics
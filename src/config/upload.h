@@ -0,0 +1,33 @@
+#ifndef UPLOAD_H
+#define UPLOAD_H
+
+#include <Arduino.h>
+
+#include "response_writer.h"
+
+namespace Haptics {
+namespace Conf {
+namespace Upload {
+
+    /// Commands too big for one UDP datagram (a full `SET ALL`, a long `node_map`) are sent
+    /// in numbered chunks, acknowledged one by one, and run once every chunk arrived intact:
+    ///
+    ///     UPLOAD BEGIN <total bytes> <chunk size> <crc32 hex>   -> UPLOAD READY <chunk count>
+    ///     UPLOAD CHUNK <index> <data>                           -> UPLOAD ACK <index> <received>/<count>
+    ///     UPLOAD STATUS                                         -> UPLOAD MISSING <i,j,..> | UPLOAD COMPLETE
+    ///     UPLOAD COMMIT                                         -> the reply of the uploaded command
+    ///     UPLOAD ABORT
+    ///
+    /// The host resends whatever STATUS lists as missing. Chunks can arrive in any order
+    /// and duplicates are acknowledged again.
+
+    /// @brief Handles one `UPLOAD` command.
+    /// @param action BEGIN, CHUNK, STATUS, COMMIT or ABORT
+    /// @param value everything after the action
+    void handle(const String &action, const String &value, ResponseWriter &out);
+
+} // namespace Upload
+} // namespace Conf
+} // namespace Haptics
+
+#endif // UPLOAD_H
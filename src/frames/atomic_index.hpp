@@ -0,0 +1,47 @@
+#ifndef FRAMES_ATOMIC_INDEX_HPP
+#define FRAMES_ATOMIC_INDEX_HPP
+
+#if !defined(ESP8266)
+#include <atomic>
+#endif
+
+namespace Haptics {
+namespace Frames {
+
+    /// A small integer shared between one producer and one consumer.
+#if defined(ESP8266)
+    // single core without tasks, both sides run from loop() and can't interleave
+    template <typename T>
+    class AtomicIndex {
+    public:
+        constexpr AtomicIndex(T initial) : value(initial) {}
+        T load() const { return value; }
+        void store(T next) { value = next; }
+        T exchange(T next)
+        {
+            const T previous = value;
+            value = next;
+            return previous;
+        }
+
+    private:
+        volatile T value;
+    };
+#else
+    template <typename T>
+    class AtomicIndex {
+    public:
+        constexpr AtomicIndex(T initial) : value(initial) {}
+        T load() const { return value.load(std::memory_order_acquire); }
+        void store(T next) { value.store(next, std::memory_order_release); }
+        T exchange(T next) { return value.exchange(next, std::memory_order_acq_rel); }
+
+    private:
+        std::atomic<T> value;
+    };
+#endif
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_ATOMIC_INDEX_HPP
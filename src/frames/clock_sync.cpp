@@ -0,0 +1,97 @@
+#include "clock_sync.h"
+
+namespace Haptics {
+namespace Frames {
+
+    void ClockSync::addSample(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4, int64_t nowUs)
+    {
+        // round trip minus the host's own processing time
+        const int32_t delay = (int32_t)(t4 - t1) - (int32_t)(t3 - t2);
+        // a reply can't take negative time, that was a mismatched or bogus exchange
+        if (delay < 0 || (int32_t)(t4 - t1) < 0)
+            return;
+
+        // host minus local, once on the way out and once on the way back, averaged
+        const uint32_t outbound = t2 - t1;
+        const uint32_t inbound = t3 - t4;
+        Sample &sample = window[next];
+        sample.offsetUs = outbound + (uint32_t)((int32_t)(inbound - outbound) / 2);
+        sample.delayUs = (uint32_t)delay;
+        sample.atUs = nowUs;
+        next = (next + 1) % SYNC_SAMPLES;
+        if (filled < SYNC_SAMPLES)
+            filled++;
+        sampleCount++;
+
+        trusted = *best();
+        if (!hasTrusted)
+        {
+            driftReference = trusted;
+            hasTrusted = true;
+            return;
+        }
+
+        // drift from the change between trusted samples far enough apart, smoothed over a few of them
+        const int64_t elapsedUs = trusted.atUs - driftReference.atUs;
+        if (elapsedUs >= SYNC_DRIFT_MIN_US)
+        {
+            const int32_t slope = (int32_t)((int64_t)(int32_t)(trusted.offsetUs - driftReference.offsetUs) * 1000000 / elapsedUs);
+            drift = hasDrift ? drift + (slope - drift) / 4 : slope;
+            hasDrift = true;
+            driftReference = trusted;
+        }
+    }
+
+    void ClockSync::reset()
+    {
+        filled = 0;
+        next = 0;
+        sampleCount = 0;
+        hasTrusted = false;
+        drift = 0;
+        hasDrift = false;
+    }
+
+    const ClockSync::Sample *ClockSync::best() const
+    {
+        const Sample *best = &window[0];
+        for (uint8_t i = 1; i < filled; i++)
+        {
+            if (window[i].delayUs < best->delayUs)
+                best = &window[i];
+        }
+        return best;
+    }
+
+    bool ClockSync::synced(int64_t nowUs) const
+    {
+        return hasTrusted && nowUs - window[(next + SYNC_SAMPLES - 1) % SYNC_SAMPLES].atUs < SYNC_TIMEOUT_US;
+    }
+
+    uint32_t ClockSync::offsetUs(int64_t nowUs) const
+    {
+        if (!hasTrusted)
+            return 0;
+        const int64_t correction = (int64_t)drift * (nowUs - trusted.atUs) / 1000000;
+        return trusted.offsetUs + (uint32_t)(int32_t)correction;
+    }
+
+    uint32_t ClockSync::errorUs(int64_t nowUs) const
+    {
+        if (!hasTrusted)
+            return UINT32_MAX;
+        const int64_t driftError = (int64_t)(drift < 0 ? -drift : drift) * (nowUs - trusted.atUs) / 1000000;
+        return trusted.delayUs / 2 + (uint32_t)driftError;
+    }
+
+    bool ClockSync::toLocal(uint32_t hostUs, int64_t nowUs, int64_t &localUs) const
+    {
+        if (!synced(nowUs))
+            return false;
+        const uint32_t local = hostUs - offsetUs(nowUs);
+        localUs = nowUs + (int32_t)(local - (uint32_t)nowUs);
+        return true;
+    }
+
+} // namespace Frames
+} // namespace Haptics
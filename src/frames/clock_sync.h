@@ -0,0 +1,73 @@
+#ifndef FRAMES_CLOCK_SYNC_H
+#define FRAMES_CLOCK_SYNC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Frames {
+
+    /// Estimates the host clock from NTP-style exchanges: we send t1, the host stamps its
+    /// receive (t2) and send (t3) times, we stamp the reply's arrival (t4). Timestamps are
+    /// microseconds truncated to 32 bits on both sides, all math wraps, so it works
+    /// whatever the host's epoch is.
+    ///
+    /// The sample with the smallest round trip in the last `SYNC_SAMPLES` is trusted, and
+    /// the drift measured between trusted samples extrapolates the offset from there.
+    class ClockSync {
+    public:
+        /// @brief Adds one completed exchange.
+        /// @param nowUs local 64-bit time of t4
+        void addSample(uint32_t t1, uint32_t t2, uint32_t t3, uint32_t t4, int64_t nowUs);
+
+        /// @brief Forgets every sample, for when the host (and so its clock) changes.
+        void reset();
+
+        /// @brief Whether a sample arrived within `SYNC_TIMEOUT_US`.
+        bool synced(int64_t nowUs) const;
+
+        /// @brief Converts a host timestamp into local time.
+        /// @param hostUs host time, truncated to 32 bits
+        /// @param nowUs current local time, the result is within ±35 minutes of it
+        /// @param localUs filled with the local time of `hostUs`
+        /// @return false if not synced
+        bool toLocal(uint32_t hostUs, int64_t nowUs, int64_t &localUs) const;
+
+        /// @brief Host clock minus local clock, truncated to 32 bits.
+        uint32_t offsetUs(int64_t nowUs) const;
+
+        /// @brief Worst case error of `offsetUs`: half the trusted round trip plus the drift since.
+        uint32_t errorUs(int64_t nowUs) const;
+
+        /// @brief How fast the host clock runs against ours, in parts per million.
+        int32_t driftPpm() const { return drift; }
+
+        uint32_t samples() const { return sampleCount; }
+
+    private:
+        struct Sample {
+            uint32_t offsetUs;
+            uint32_t delayUs;
+            int64_t atUs;
+        };
+
+        const Sample *best() const;
+
+        Sample window[SYNC_SAMPLES] = {};
+        uint8_t filled = 0;
+        uint8_t next = 0;
+        uint32_t sampleCount = 0;
+
+        Sample trusted = {};
+        Sample driftReference = {};
+        bool hasTrusted = false;
+        int32_t drift = 0;
+        bool hasDrift = false;
+    };
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_CLOCK_SYNC_H
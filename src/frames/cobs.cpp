@@ -0,0 +1,32 @@
+#include "cobs.h"
+
+namespace Haptics {
+namespace Frames {
+
+    size_t cobsDecode(const uint8_t *in, size_t len, uint8_t *out)
+    {
+        // the output never overtakes the input, so decoding in place is safe
+        size_t read = 0;
+        size_t written = 0;
+        while (read < len)
+        {
+            const uint8_t code = in[read++];
+            if (code == 0 || read + code - 1 > len)
+                return 0;
+
+            for (uint8_t i = 1; i < code; i++)
+            {
+                if (in[read] == 0)
+                    return 0;
+                out[written++] = in[read++];
+            }
+
+            // a full 254 byte block isn't followed by a zero, neither is the last block
+            if (code != 0xff && read < len)
+                out[written++] = 0;
+        }
+        return written;
+    }
+
+} // namespace Frames
+} // namespace Haptics
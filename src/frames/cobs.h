@@ -0,0 +1,31 @@
+#ifndef FRAMES_COBS_H
+#define FRAMES_COBS_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Haptics {
+namespace Frames {
+
+    /// Consistent Overhead Byte Stuffing, used to frame binary packets on the serial port.
+    /// An encoded packet never contains 0x00, so 0x00 can delimit packets on a byte stream
+    /// and the receiver resynchronizes at the next delimiter after any corruption.
+
+    /// @brief Decodes one COBS packet, without its 0x00 delimiters.
+    /// @param in the encoded bytes
+    /// @param len number of encoded bytes
+    /// @param out destination, may be `in` to decode in place, needs `len` bytes at most
+    /// @return length of the decoded packet, 0 if it was empty or malformed
+    size_t cobsDecode(const uint8_t *in, size_t len, uint8_t *out);
+
+    /// @brief Longest encoding of a `len` byte packet, delimiters not included.
+    /// One spare byte covers encoders that end a full block with an empty one.
+    constexpr size_t cobsMaxEncoded(size_t len)
+    {
+        return len + len / 254 + 2;
+    }
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_COBS_H
@@ -0,0 +1,477 @@
+#include <string.h>
+
+#include "codec.h"
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Frames {
+
+    /// Maps every byte to its hex value, or -1 when it isn't a hex digit.
+    struct NibbleTable {
+        int8_t value[256];
+
+        constexpr NibbleTable() : value()
+        {
+            for (int i = 0; i < 256; i++)
+                value[i] = -1;
+            for (int i = 0; i < 10; i++)
+                value['0' + i] = i;
+            for (int i = 0; i < 6; i++)
+            {
+                value['a' + i] = 10 + i;
+                value['A' + i] = 10 + i;
+            }
+        }
+    };
+
+    static constexpr NibbleTable nibbles;
+
+    size_t decodeBlob16(const uint8_t *data, size_t len, uint16_t *out, size_t maxOut)
+    {
+        if (len % 2 != 0)
+            return 0;
+
+        size_t count = len / 2;
+        if (count > maxOut)
+            count = maxOut;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = (uint16_t)((data[2 * i] << 8) | data[2 * i + 1]);
+        }
+        return count;
+    }
+
+    size_t decodeHex16(const char *str, size_t len, uint16_t *out, size_t maxOut)
+    {
+        static_assert(OSC_MOTOR_CHAR_NUM == 4, "decodeHex16 expects 4 hex characters per motor");
+
+        if (len % OSC_MOTOR_CHAR_NUM != 0)
+            return 0;
+
+        size_t count = len / OSC_MOTOR_CHAR_NUM;
+        if (count > maxOut)
+            count = maxOut;
+
+        // validate the whole frame first so a bad character never leaves a half applied frame
+        const uint8_t *chars = (const uint8_t *)str;
+        for (size_t i = 0; i < count * OSC_MOTOR_CHAR_NUM; i += OSC_MOTOR_CHAR_NUM)
+        {
+            if ((nibbles.value[chars[i]] | nibbles.value[chars[i + 1]] |
+                 nibbles.value[chars[i + 2]] | nibbles.value[chars[i + 3]]) < 0)
+                return 0;
+        }
+
+        // one motor (4 characters) per iteration
+        for (size_t i = 0; i < count; i++, chars += OSC_MOTOR_CHAR_NUM)
+        {
+            out[i] = (uint16_t)((nibbles.value[chars[0]] << 12) |
+                                (nibbles.value[chars[1]] << 8) |
+                                (nibbles.value[chars[2]] << 4) |
+                                nibbles.value[chars[3]]);
+        }
+        return count;
+    }
+
+    size_t decodeBlob8(const uint8_t *data, size_t len, uint16_t *out, size_t maxOut)
+    {
+        const size_t count = len < maxOut ? len : maxOut;
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = expand8(data[i]);
+        }
+        return count;
+    }
+
+    size_t decodeHex8(const char *str, size_t len, uint16_t *out, size_t maxOut)
+    {
+        if (len % 2 != 0)
+            return 0;
+
+        size_t count = len / 2;
+        if (count > maxOut)
+            count = maxOut;
+
+        const uint8_t *chars = (const uint8_t *)str;
+        for (size_t i = 0; i < count * 2; i += 2)
+        {
+            if ((nibbles.value[chars[i]] | nibbles.value[chars[i + 1]]) < 0)
+                return 0;
+        }
+
+        for (size_t i = 0; i < count; i++, chars += 2)
+        {
+            out[i] = expand8((uint8_t)((nibbles.value[chars[0]] << 4) | nibbles.value[chars[1]]));
+        }
+        return count;
+    }
+
+    size_t decodeSparse16(const uint8_t *data, size_t len, uint16_t *out, size_t maxOut)
+    {
+        if (len % 4 != 0)
+            return 0;
+
+        const size_t count = len / 4;
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint16_t index = (uint16_t)((data[4 * i] << 8) | data[4 * i + 1]);
+            if (index >= maxOut)
+                return 0;
+        }
+
+        for (size_t i = 0; i < count; i++, data += 4)
+        {
+            const uint16_t index = (uint16_t)((data[0] << 8) | data[1]);
+            out[index] = (uint16_t)((data[2] << 8) | data[3]);
+        }
+        return count;
+    }
+
+    size_t decodeGroup(const uint8_t *data, size_t len, const uint16_t *groups, uint16_t *out, size_t count)
+    {
+        static_assert(MAX_NODE_GROUPS <= 16, "motor group masks are 16 bits");
+
+        if (len == 0 || len % 6 != 0)
+            return 0;
+
+        // validate every entry first, like the sparse frames a bad entry rejects the whole update
+        const size_t entries = len / 6;
+        for (size_t i = 0; i < entries; i++)
+        {
+            const uint16_t mask = (uint16_t)((data[6 * i] << 8) | data[6 * i + 1]);
+            if ((mask >> MAX_NODE_GROUPS) != 0 || data[6 * i + 2] > GROUP_SCALE)
+                return 0;
+        }
+
+        for (size_t i = 0; i < entries; i++, data += 6)
+        {
+            const uint16_t mask = (uint16_t)((data[0] << 8) | data[1]);
+            const uint16_t value = (uint16_t)((data[4] << 8) | data[5]);
+            for (size_t motor = 0; motor < count; motor++)
+            {
+                if (!(groups[motor] & mask))
+                    continue;
+                if (data[2] == GROUP_SET)
+                {
+                    out[motor] = value;
+                }
+                else
+                {
+                    const uint32_t scaled = ((uint32_t)out[motor] * value) >> 8;
+                    out[motor] = scaled > UINT16_MAX ? UINT16_MAX : (uint16_t)scaled;
+                }
+            }
+        }
+        return entries;
+    }
+
+    size_t decodeFrame(FrameKind kind, const uint8_t *payload, size_t len, uint16_t *out, size_t maxOut)
+    {
+        switch (kind)
+        {
+        case FRAME_HEX16:
+            return decodeHex16((const char *)payload, len, out, maxOut);
+        case FRAME_BLOB16:
+            return decodeBlob16(payload, len, out, maxOut);
+        case FRAME_SPARSE16:
+            return decodeSparse16(payload, len, out, maxOut);
+        case FRAME_HEX8:
+            return decodeHex8((const char *)payload, len, out, maxOut);
+        case FRAME_BLOB8:
+            return decodeBlob8(payload, len, out, maxOut);
+        case FRAME_TIMED16:
+        case FRAME_TIMED8:
+        {
+            uint32_t hostUs;
+            const uint8_t *values;
+            size_t valuesLen;
+            if (!parseTimed(payload, len, hostUs, values, valuesLen))
+                return 0;
+            return kind == FRAME_TIMED16 ? decodeBlob16(values, valuesLen, out, maxOut) : decodeBlob8(values, valuesLen, out, maxOut);
+        }
+        default:
+            return 0;
+        }
+    }
+
+    size_t parseBundle(const uint8_t *data, size_t len, BundleFrame *frames, size_t maxFrames, size_t bytesPerMotor)
+    {
+        if (len < 4)
+            return 0;
+
+        const size_t count = data[0];
+        const size_t motors = (size_t)((data[2] << 8) | data[3]);
+        const size_t frameSize = 4 + bytesPerMotor * motors;
+        if (count == 0 || count > maxFrames || len != 4 + count * frameSize)
+            return 0;
+
+        data += 4;
+        for (size_t i = 0; i < count; i++, data += frameSize)
+        {
+            frames[i].offsetUs = ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+            frames[i].payload = data + 4;
+            frames[i].payloadLen = bytesPerMotor * motors;
+        }
+        return count;
+    }
+
+    FrameKind frameKindForAddress(const char *address)
+    {
+        if (strcmp(address, MOTOR_ADDRESS) == 0)
+            return FRAME_HEX16;
+        if (strcmp(address, MOTOR_BLOB_ADDRESS) == 0)
+            return FRAME_BLOB16;
+        if (strcmp(address, MOTOR_SPARSE_ADDRESS) == 0)
+            return FRAME_SPARSE16;
+        if (strcmp(address, MOTOR_BUNDLE_ADDRESS) == 0)
+            return FRAME_BUNDLE16;
+        if (strcmp(address, MOTOR_TIMED_ADDRESS) == 0)
+            return FRAME_TIMED16;
+        if (strcmp(address, MOTOR_GROUP_ADDRESS) == 0)
+            return FRAME_GROUP16;
+        return FRAME_UNKNOWN;
+    }
+
+    /// @brief Shifts motors `[offset, offset + count)` of a dense layout to the start of `payload`.
+    static size_t sliceDense(uint8_t *payload, size_t len, size_t unit, size_t offset, size_t count)
+    {
+        if (len % unit != 0 || len / unit <= offset)
+            return 0;
+
+        const size_t available = len / unit - offset;
+        const size_t motors = available < count ? available : count;
+        memmove(payload, payload + offset * unit, motors * unit);
+        return motors * unit;
+    }
+
+    static size_t sliceSparse(uint8_t *payload, size_t len, size_t offset, size_t count)
+    {
+        if (len % 4 != 0)
+            return 0;
+
+        size_t kept = 0;
+        for (size_t i = 0; i < len; i += 4)
+        {
+            const size_t index = (size_t)((payload[i] << 8) | payload[i + 1]);
+            if (index < offset || index >= offset + count)
+                continue;
+
+            const size_t local = index - offset;
+            payload[kept] = (uint8_t)(local >> 8);
+            payload[kept + 1] = (uint8_t)local;
+            payload[kept + 2] = payload[i + 2];
+            payload[kept + 3] = payload[i + 3];
+            kept += 4;
+        }
+        return kept;
+    }
+
+    static size_t sliceBundle(uint8_t *payload, size_t len, size_t bytesPerMotor, size_t offset, size_t count)
+    {
+        BundleFrame frames[MAX_QUEUED_FRAMES];
+        const size_t frameCount = parseBundle(payload, len, frames, MAX_QUEUED_FRAMES, bytesPerMotor);
+        if (frameCount == 0)
+            return 0;
+
+        const size_t motors = frames[0].payloadLen / bytesPerMotor;
+        if (motors <= offset)
+            return 0;
+        const size_t kept = motors - offset < count ? motors - offset : count;
+
+        // every frame shrinks, so writing front to back never overtakes unread data
+        uint8_t *write = payload + 4;
+        for (size_t i = 0; i < frameCount; i++)
+        {
+            memmove(write, frames[i].payload - 4, 4);
+            memmove(write + 4, frames[i].payload + offset * bytesPerMotor, kept * bytesPerMotor);
+            write += 4 + kept * bytesPerMotor;
+        }
+        payload[2] = (uint8_t)(kept >> 8);
+        payload[3] = (uint8_t)kept;
+        return write - payload;
+    }
+
+    size_t sliceFrame(FrameKind kind, uint8_t *payload, size_t len, size_t offset, size_t count)
+    {
+        switch (kind)
+        {
+        case FRAME_HEX16:
+            return sliceDense(payload, len, OSC_MOTOR_CHAR_NUM, offset, count);
+        case FRAME_HEX8:
+        case FRAME_BLOB16:
+            return sliceDense(payload, len, 2, offset, count);
+        case FRAME_BLOB8:
+            return sliceDense(payload, len, 1, offset, count);
+        case FRAME_SPARSE16:
+            return sliceSparse(payload, len, offset, count);
+        case FRAME_BUNDLE16:
+            return sliceBundle(payload, len, 2, offset, count);
+        case FRAME_BUNDLE8:
+            return sliceBundle(payload, len, 1, offset, count);
+        case FRAME_TIMED16:
+        case FRAME_TIMED8:
+        {
+            // the host time stays in front, only the values behind it are cut
+            if (len < 4)
+                return 0;
+            const size_t sliced = sliceDense(payload + 4, len - 4, kind == FRAME_TIMED16 ? 2 : 1, offset, count);
+            return sliced ? 4 + sliced : 0;
+        }
+        case FRAME_GROUP16:
+            // groups are configured per board, every board applies the same entries to its own motors
+            return len;
+        default:
+            return 0;
+        }
+    }
+
+    FrameKind withMotorBits(FrameKind kind, uint8_t motorBits)
+    {
+        if (motorBits != 8)
+            return kind;
+
+        switch (kind)
+        {
+        case FRAME_HEX16:
+            return FRAME_HEX8;
+        case FRAME_BLOB16:
+            return FRAME_BLOB8;
+        case FRAME_BUNDLE16:
+            return FRAME_BUNDLE8;
+        case FRAME_TIMED16:
+            return FRAME_TIMED8;
+        default:
+            return kind;
+        }
+    }
+
+    /// @brief Length of an OSC string including its null terminator and padding, 0 if unterminated.
+    static size_t oscStringSize(const uint8_t *data, size_t len)
+    {
+        const uint8_t *end = (const uint8_t *)memchr(data, 0, len);
+        if (!end)
+            return 0;
+        const size_t padded = ((end - data) + 4) & ~(size_t)3;
+        return padded <= len ? padded : 0;
+    }
+
+    static uint32_t readBigEndian32(const uint8_t *data)
+    {
+        return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | data[3];
+    }
+
+    bool parseTimed(const uint8_t *data, size_t len, uint32_t &hostUs, const uint8_t *&payload, size_t &payloadLen)
+    {
+        if (len < 4)
+            return false;
+
+        hostUs = readBigEndian32(data);
+        payload = data + 4;
+        payloadLen = len - 4;
+        return true;
+    }
+
+    bool parseRawMotorMessage(const uint8_t *packet, size_t len, RawMotorMessage &out)
+    {
+        // address
+        if (len < 4 || packet[0] != '/')
+            return false;
+        const size_t addressSize = oscStringSize(packet, len);
+        if (addressSize == 0)
+            return false;
+        out.kind = frameKindForAddress((const char *)packet);
+        if (out.kind == FRAME_UNKNOWN)
+            return false;
+        packet += addressSize;
+        len -= addressSize;
+
+        // type tags, ",s" ",si" ",sii" ",b" ",bi" or ",bii"
+        const size_t tagsSize = oscStringSize(packet, len);
+        if (tagsSize == 0 || packet[0] != ',')
+            return false;
+        const char payloadTag = (char)packet[1];
+        const char sequenceTag = payloadTag ? (char)packet[2] : 0;
+        const char tokenTag = sequenceTag ? (char)packet[3] : 0;
+        if (payloadTag != 's' && payloadTag != 'b')
+            return false;
+        if (sequenceTag != 0 && sequenceTag != 'i')
+            return false;
+        if (tokenTag != 0 && (tokenTag != 'i' || packet[4] != 0))
+            return false;
+        packet += tagsSize;
+        len -= tagsSize;
+
+        // payload argument
+        size_t argSize = 0;
+        if (payloadTag == 's')
+        {
+            argSize = oscStringSize(packet, len);
+            if (argSize == 0)
+                return false;
+            out.payload = packet;
+            out.payloadLen = strlen((const char *)packet);
+        }
+        else
+        {
+            if (len < 4)
+                return false;
+            const uint32_t blobLen = readBigEndian32(packet);
+            argSize = 4 + ((blobLen + 3) & ~(uint32_t)3);
+            if (blobLen > len - 4 || argSize > len)
+                return false;
+            out.payload = packet + 4;
+            out.payloadLen = blobLen;
+        }
+        packet += argSize;
+        len -= argSize;
+
+        // optional sequence number
+        out.hasSequence = sequenceTag == 'i';
+        out.sequence = 0;
+        if (out.hasSequence)
+        {
+            if (len < 4)
+                return false;
+            out.sequence = readBigEndian32(packet);
+            packet += 4;
+            len -= 4;
+        }
+
+        // optional trace token
+        out.hasToken = tokenTag == 'i';
+        out.token = 0;
+        if (out.hasToken)
+        {
+            if (len < 4)
+                return false;
+            out.token = readBigEndian32(packet);
+        }
+        return true;
+    }
+
+    bool parseRawCommand(const uint8_t *packet, size_t len, const char *&text, size_t &textLen)
+    {
+        if (len < 4 || packet[0] != '/')
+            return false;
+        const size_t addressSize = oscStringSize(packet, len);
+        if (addressSize == 0 || strcmp((const char *)packet, COMMAND_ADDRESS) != 0)
+            return false;
+        packet += addressSize;
+        len -= addressSize;
+
+        // exactly one string argument
+        const size_t tagsSize = oscStringSize(packet, len);
+        if (tagsSize == 0 || packet[0] != ',' || packet[1] != 's' || packet[2] != 0)
+            return false;
+        packet += tagsSize;
+        len -= tagsSize;
+
+        if (oscStringSize(packet, len) == 0)
+            return false;
+        text = (const char *)packet;
+        textLen = strlen(text);
+        return true;
+    }
+
+} // namespace Frames
+} // namespace Haptics
@@ -0,0 +1,207 @@
+#ifndef FRAMES_CODEC_H
+#define FRAMES_CODEC_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// Motor frame decoders. Kept free of Arduino types so they can be built and
+/// exercised on a desktop host as well as on the boards.
+
+namespace Haptics {
+namespace Frames {
+
+    /// The motor frame layouts, one per motor address.
+    enum FrameKind {
+        FRAME_UNKNOWN,
+        /// `MOTOR_ADDRESS`, 4 hex characters per motor
+        FRAME_HEX16,
+        /// `MOTOR_BLOB_ADDRESS`, big-endian uint16 per motor
+        FRAME_BLOB16,
+        /// `MOTOR_SPARSE_ADDRESS`, big-endian (uint16 index, uint16 value) pairs
+        FRAME_SPARSE16,
+        /// `MOTOR_BUNDLE_ADDRESS`, several uint16 frames with relative playout offsets
+        FRAME_BUNDLE16,
+        /// `MOTOR_ADDRESS` in an 8-bit session, 2 hex characters per motor
+        FRAME_HEX8,
+        /// `MOTOR_BLOB_ADDRESS` in an 8-bit session, one byte per motor
+        FRAME_BLOB8,
+        /// `MOTOR_BUNDLE_ADDRESS` in an 8-bit session
+        FRAME_BUNDLE8,
+        /// `MOTOR_TIMED_ADDRESS`, big-endian uint32 host time then `FRAME_BLOB16` values
+        FRAME_TIMED16,
+        /// `MOTOR_TIMED_ADDRESS` in an 8-bit session, host time then `FRAME_BLOB8` values
+        FRAME_TIMED8,
+        /// `MOTOR_GROUP_ADDRESS`, group entries expanded through the configured `motor_groups`
+        FRAME_GROUP16,
+    };
+
+    /// What a `FRAME_GROUP16` entry does to the motors in its groups.
+    enum GroupMode {
+        /// motors take the entry's value
+        GROUP_SET = 0,
+        /// motors are multiplied by the entry's value in 8.8 fixed point, 256 keeps them as they are
+        GROUP_SCALE = 1,
+    };
+
+    /// One frame inside a `FRAME_BUNDLE16` or `FRAME_BUNDLE8` bundle.
+    struct BundleFrame {
+        /// @brief Microseconds after the bundle's arrival the frame should be output at.
+        uint32_t offsetUs;
+        /// @brief Packed motor values, `decodeBlob16` or `decodeBlob8` layout.
+        const uint8_t *payload;
+        size_t payloadLen;
+    };
+
+    /// A motor frame located inside a raw OSC packet, nothing is copied out of the packet.
+    struct RawMotorMessage {
+        FrameKind kind;
+        /// @brief The string characters or blob bytes of the first argument.
+        const uint8_t *payload;
+        size_t payloadLen;
+        /// @brief Whether the optional int32 sequence number argument was present.
+        bool hasSequence;
+        uint32_t sequence;
+        /// @brief Whether the optional int32 trace token argument, after the sequence number, was present.
+        bool hasToken;
+        uint32_t token;
+    };
+
+    /// @brief Maps an OSC address onto the frame layout it carries.
+    FrameKind frameKindForAddress(const char *address);
+
+    /// @brief Swaps a 16-bit layout for its 8-bit variant when the session negotiated 8-bit motors.
+    /// @param kind layout as returned by `frameKindForAddress`
+    /// @param motorBits 8 or 16, layouts without an 8-bit variant are returned unchanged
+    FrameKind withMotorBits(FrameKind kind, uint8_t motorBits);
+
+    /// @brief Expands an 8-bit intensity onto the 16-bit pipeline, 0xff becomes 0xffff.
+    inline uint16_t expand8(uint8_t value)
+    {
+        return (uint16_t)((value << 8) | value);
+    }
+
+    /// @brief Locates the motor frame in a raw OSC message without building an `OscMessage`.
+    ///
+    /// Only the fixed motor addresses with a `s`/`b` first argument, an optional `i`
+    /// sequence number and an optional `i` trace token after it are understood,
+    /// OSC bundles and anything else are rejected.
+    /// @param packet the UDP payload
+    /// @param len length of the UDP payload
+    /// @param out filled with spans into `packet`
+    /// @return whether `packet` was a motor frame
+    bool parseRawMotorMessage(const uint8_t *packet, size_t len, RawMotorMessage &out);
+
+    /// @brief Locates the command string in a raw `COMMAND_ADDRESS` OSC message.
+    /// @param packet the UDP payload
+    /// @param len length of the UDP payload
+    /// @param text filled with the null terminated command, inside `packet`
+    /// @param textLen filled with the length of the command
+    /// @return whether `packet` was a command with a single string argument
+    bool parseRawCommand(const uint8_t *packet, size_t len, const char *&text, size_t &textLen);
+
+    /// @brief Splits a `FRAME_BUNDLE16` or `FRAME_BUNDLE8` bundle into its frames.
+    ///
+    /// Layout: uint8 frame count, uint8 reserved, uint16 motors per frame, then for each
+    /// frame a uint32 offset in microseconds followed by the motor values. All big-endian.
+    /// @param data start of the blob payload
+    /// @param len length of the blob in bytes
+    /// @param frames filled with spans into `data`
+    /// @param maxFrames capacity of `frames`, larger bundles are rejected
+    /// @param bytesPerMotor 2 for `FRAME_BUNDLE16`, 1 for `FRAME_BUNDLE8`
+    /// @return number of frames, 0 if the bundle was malformed
+    size_t parseBundle(const uint8_t *data, size_t len, BundleFrame *frames, size_t maxFrames, size_t bytesPerMotor);
+
+    /// @brief Splits a `FRAME_TIMED16` or `FRAME_TIMED8` frame into its host time and motor values.
+    /// @param data start of the blob payload
+    /// @param len length of the blob in bytes
+    /// @param hostUs filled with the host time, in microseconds, the frame should be output at
+    /// @param payload filled with the start of the `decodeBlob16` or `decodeBlob8` values
+    /// @param payloadLen filled with the length of the values
+    /// @return false if the blob was too short to hold a time
+    bool parseTimed(const uint8_t *data, size_t len, uint32_t &hostUs, const uint8_t *&payload, size_t &payloadLen);
+
+    /// @brief Cuts one device's motors out of a frame addressed to several devices.
+    ///
+    /// The payload is rewritten in place so it reads as if it only ever held motors
+    /// `[offset, offset + count)`: dense layouts are shifted down, sparse pairs outside the
+    /// slice are dropped and re-indexed, and every bundle frame is cut the same way.
+    /// @param kind layout of `payload`
+    /// @param payload frame payload, overwritten with the slice
+    /// @param len length of `payload`
+    /// @param offset first motor of the slice
+    /// @param count number of motors in the slice
+    /// @return length of the sliced payload, 0 if the frame was malformed or holds nothing for this slice
+    size_t sliceFrame(FrameKind kind, uint8_t *payload, size_t len, size_t offset, size_t count);
+
+    /// @brief Decodes any motor frame layout onto `out`.
+    /// `FRAME_GROUP16` needs the group config and is decoded with `decodeGroup` instead.
+    /// @return number of motor values written, 0 if the frame was malformed
+    size_t decodeFrame(FrameKind kind, const uint8_t *payload, size_t len, uint16_t *out, size_t maxOut);
+
+    /// @brief Decodes a blob of packed big-endian uint16 motor values.
+    /// @param data start of the blob payload
+    /// @param len length of the blob in bytes, must be a multiple of two
+    /// @param out destination motor array (usually the `Receiver`'s values)
+    /// @param maxOut capacity of `out`, extra values in the blob are ignored
+    /// @return number of motor values written, 0 if the blob was malformed
+    size_t decodeBlob16(const uint8_t *data, size_t len, uint16_t *out, size_t maxOut);
+
+    /// @brief Decodes a string of 4 hex characters per motor, as sent to `MOTOR_ADDRESS`.
+    /// @param str start of the hex characters, does not need to be null terminated
+    /// @param len number of characters, must be a multiple of `OSC_MOTOR_CHAR_NUM`
+    /// @param out destination motor array (usually the `Receiver`'s values)
+    /// @param maxOut capacity of `out`, extra values in the string are ignored
+    /// @return number of motor values written, 0 if any character was not hex or the length was uneven
+    size_t decodeHex16(const char *str, size_t len, uint16_t *out, size_t maxOut);
+
+    /// @brief Decodes a blob of one byte per motor, expanded to 16 bits.
+    /// @return number of motor values written, 0 if the blob was empty
+    size_t decodeBlob8(const uint8_t *data, size_t len, uint16_t *out, size_t maxOut);
+
+    /// @brief Decodes a string of 2 hex characters per motor, expanded to 16 bits.
+    /// @return number of motor values written, 0 if any character was not hex or the length was odd
+    size_t decodeHex8(const char *str, size_t len, uint16_t *out, size_t maxOut);
+
+    /// @brief Applies a group update onto the motors whose group mask matches.
+    ///
+    /// Layout: entries of big-endian uint16 group mask, uint8 `GroupMode`, uint8 reserved and
+    /// uint16 value, applied in order so a later entry can scale what an earlier one set.
+    /// @param data start of the blob payload
+    /// @param len length of the blob in bytes, must be a multiple of six
+    /// @param groups each motor's group mask, bit n is group n
+    /// @param out motor array the entries are applied onto, motors outside the groups keep their value
+    /// @param count number of motors in `groups` and `out`
+    /// @return number of entries applied, 0 if the update was malformed
+    size_t decodeGroup(const uint8_t *data, size_t len, const uint16_t *groups, uint16_t *out, size_t count);
+
+    /// @brief Applies a sparse update of packed big-endian (uint16 index, uint16 value) pairs.
+    /// @param data start of the blob payload
+    /// @param len length of the blob in bytes, must be a multiple of four
+    /// @param out motor array the pairs are applied onto, untouched motors keep their value
+    /// @param maxOut capacity of `out`, any index past it rejects the whole update
+    /// @return number of pairs applied, 0 if the update was malformed or empty (see `isKeepalive`)
+    size_t decodeSparse16(const uint8_t *data, size_t len, uint16_t *out, size_t maxOut);
+
+    /// @brief Whether a frame is an empty sparse update, which a delta host sends while nothing
+    /// changed so the failsafe knows it is still there. It decodes to 0 values but isn't malformed.
+    inline bool isKeepalive(FrameKind kind, size_t len)
+    {
+        return kind == FRAME_SPARSE16 && len == 0;
+    }
+
+    /// @brief Marks a single motor as changed in a dirty bitmap.
+    inline void markDirty(uint32_t *dirty, size_t index)
+    {
+        dirty[index / 32] |= 1UL << (index % 32);
+    }
+
+    /// @brief Checks whether a motor is marked as changed in a dirty bitmap.
+    inline bool isDirty(const uint32_t *dirty, size_t index)
+    {
+        return dirty[index / 32] & (1UL << (index % 32));
+    }
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_CODEC_H
@@ -0,0 +1,47 @@
+#include <string.h>
+
+#include "failsafe.h"
+#include "codec.h"
+
+namespace Haptics {
+namespace Frames {
+
+    bool Failsafe::update(int64_t nowUs, uint32_t holdUs, uint32_t fadeUs, uint16_t *out, uint32_t *dirty, size_t count)
+    {
+        if (state == FAILSAFE_ZERO)
+            return false;
+
+        const int64_t elapsedUs = nowUs - lastFrameUs;
+        if (elapsedUs <= (int64_t)holdUs)
+            return false;
+
+        if (state == FAILSAFE_LIVE)
+        {
+            // fade from whatever was held
+            memcpy(from, out, count * sizeof(from[0]));
+            state = FAILSAFE_FADING;
+        }
+
+        const int64_t fadeElapsedUs = elapsedUs - holdUs;
+        // 16.16 share of the held value still left, 0 once the fade is over
+        uint32_t scale = 0;
+        if (fadeElapsedUs < (int64_t)fadeUs)
+            scale = (uint32_t)(((uint64_t)(fadeUs - fadeElapsedUs) << 16) / fadeUs);
+        else
+            state = FAILSAFE_ZERO;
+
+        bool changed = false;
+        for (size_t i = 0; i < count; i++)
+        {
+            const uint16_t value = (uint16_t)(((uint32_t)from[i] * scale) >> 16);
+            if (value == out[i])
+                continue;
+            out[i] = value;
+            markDirty(dirty, i);
+            changed = true;
+        }
+        return changed;
+    }
+
+} // namespace Frames
+} // namespace Haptics
@@ -0,0 +1,48 @@
+#ifndef FRAMES_FAILSAFE_H
+#define FRAMES_FAILSAFE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Frames {
+
+    /// Per-frame watchdog on the output: after a gap in frames the motors first hold their
+    /// last values, which hides a dropped frame or two, then fade linearly to zero.
+    class Failsafe {
+    public:
+        /// @brief A frame was just output, the motors are live again.
+        void feed(int64_t nowUs)
+        {
+            lastFrameUs = nowUs;
+            state = FAILSAFE_LIVE;
+        }
+
+        /// @brief Holds, fades or zeroes `out` depending on how long ago the last frame was fed.
+        /// @param holdUs how long the last values are held before fading
+        /// @param fadeUs how long the fade from the held values to zero takes, 0 zeroes at once
+        /// @return whether any value in `out` changed, changed motors are marked in `dirty`
+        bool update(int64_t nowUs, uint32_t holdUs, uint32_t fadeUs, uint16_t *out, uint32_t *dirty, size_t count);
+
+        /// @brief Whether the output is currently being faded or held at zero by the watchdog.
+        bool tripped() const { return state != FAILSAFE_LIVE; }
+
+    private:
+        enum State {
+            FAILSAFE_LIVE,
+            FAILSAFE_FADING,
+            FAILSAFE_ZERO,
+        };
+
+        uint16_t from[MAX_MOTORS] = {};
+        int64_t lastFrameUs = 0;
+        // nothing is driven before the first frame
+        State state = FAILSAFE_ZERO;
+    };
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_FAILSAFE_H
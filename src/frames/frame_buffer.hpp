@@ -0,0 +1,115 @@
+#ifndef FRAMES_FRAME_BUFFER_HPP
+#define FRAMES_FRAME_BUFFER_HPP
+
+#include <stdint.h>
+#include <string.h>
+
+#include "software_defines.h"
+#include "atomic_index.hpp"
+#include "codec.h"
+#include "latency.h"
+
+namespace Haptics {
+namespace Frames {
+
+    /// One complete set of motor values, as handed from the receive path to the output path.
+    struct MotorFrame {
+        uint16_t vals[MAX_MOTORS];
+        /// @brief Increases with every frame or bundle the receive path accepts, older frames never replace newer ones.
+        uint32_t epoch;
+        FrameTiming timing;
+    };
+
+    /// A motor frame waiting in the playout queue for its release time.
+    struct ScheduledFrame {
+        MotorFrame frame;
+        /// @brief Local microsecond timestamp the frame should be output at.
+        int64_t dueUs;
+    };
+
+    /// Lock-free triple buffer between one producer and one consumer. The producer always
+    /// publishes complete values, the consumer always takes the newest one, and neither
+    /// ever waits on the other.
+    template <typename T>
+    class TripleBuffer {
+    public:
+        /// @brief Producer: the slot to fill before `publish`, only valid until then.
+        T &back() { return slots[backIndex]; }
+
+        /// @brief Producer: makes the filled `back` slot the newest value.
+        /// @return true if the previously published value was never taken (coalesced)
+        bool publish()
+        {
+            const uint8_t previous = middle.exchange(backIndex | FRESH);
+            backIndex = previous & INDEX_MASK;
+            return previous & FRESH;
+        }
+
+        /// @brief Consumer: takes the newest published value.
+        /// @return the value, valid until the next `acquire`, or nullptr if nothing new was published
+        const T *acquire()
+        {
+            if (!(middle.load() & FRESH))
+                return nullptr;
+            frontIndex = middle.exchange(frontIndex) & INDEX_MASK;
+            return &slots[frontIndex];
+        }
+
+        /// @brief Consumer: the value the last `acquire` took, zeroed before the first one.
+        const T &front() const { return slots[frontIndex]; }
+
+    private:
+        static constexpr uint8_t INDEX_MASK = 0x03;
+        static constexpr uint8_t FRESH = 0x04;
+
+        T slots[3] = {};
+        uint8_t backIndex = 0;  // only touched by the producer
+        uint8_t frontIndex = 1; // only touched by the consumer
+
+        AtomicIndex<uint8_t> middle{2};
+    };
+
+    /// Hands motor frames from the network receive path to the motor output.
+    class FrameBuffer {
+    public:
+        /// @brief Producer: publishes a copy of `vals` as the newest frame.
+        /// @param epoch the frame's receive order, see `MotorFrame::epoch`
+        /// @param timing when the frame was received and whether it is traced
+        /// @return true if the previously published frame was never taken (coalesced)
+        bool publish(const uint16_t *vals, uint32_t epoch, const FrameTiming &timing)
+        {
+            MotorFrame &frame = frames.back();
+            memcpy(frame.vals, vals, sizeof(frame.vals));
+            frame.epoch = epoch;
+            frame.timing = timing;
+            return frames.publish();
+        }
+
+        /// @brief Consumer: takes the newest published frame.
+        /// @return the frame, valid until the next `acquire`, or nullptr if nothing new was published
+        const MotorFrame *acquire() { return frames.acquire(); }
+
+    private:
+        TripleBuffer<MotorFrame> frames;
+    };
+
+    /// @brief Copies `count` values from `src` to `dst`, marking the ones that changed in `dirty`.
+    /// @return whether any value changed
+    inline bool copyChanged(const uint16_t *src, uint16_t *dst, uint32_t *dirty, size_t count)
+    {
+        bool changed = false;
+        for (size_t i = 0; i < count; i++)
+        {
+            if (src[i] == dst[i])
+                continue;
+            dst[i] = src[i];
+            markDirty(dirty, i);
+            changed = true;
+        }
+        return changed;
+    }
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_FRAME_BUFFER_HPP
@@ -0,0 +1,50 @@
+#include <string.h>
+
+#include "interpolator.h"
+#include "codec.h"
+
+namespace Haptics {
+namespace Frames {
+
+    void Interpolator::setTarget(const uint16_t *target, const uint16_t *current, size_t count, int64_t nowUs, uint32_t maxRampUs)
+    {
+        // ramp over the gap since the previous target, so we arrive just as the next one lands
+        const int64_t interval = hasLastTarget ? nowUs - lastTargetUs : 0;
+        durationUs = interval < (int64_t)maxRampUs ? (uint32_t)interval : maxRampUs;
+        lastTargetUs = nowUs;
+        hasLastTarget = true;
+
+        memcpy(from, current, count * sizeof(uint16_t));
+        memcpy(to, target, count * sizeof(uint16_t));
+        startUs = nowUs;
+        active = true;
+    }
+
+    bool Interpolator::step(int64_t nowUs, uint16_t *out, uint32_t *dirty, size_t count)
+    {
+        if (!active)
+            return false;
+
+        const int64_t elapsed = nowUs - startUs;
+        const bool finished = elapsed >= (int64_t)durationUs;
+        // progress through the ramp as a 0..65536 fraction
+        const int64_t fraction = finished ? 65536 : (elapsed << 16) / durationUs;
+
+        bool changed = false;
+        for (size_t i = 0; i < count; i++)
+        {
+            const int32_t delta = (int32_t)to[i] - (int32_t)from[i];
+            const uint16_t value = (uint16_t)(from[i] + ((delta * fraction) >> 16));
+            if (value == out[i])
+                continue;
+            out[i] = value;
+            markDirty(dirty, i);
+            changed = true;
+        }
+
+        active = !finished;
+        return changed;
+    }
+
+} // namespace Frames
+} // namespace Haptics
@@ -0,0 +1,51 @@
+#ifndef FRAMES_INTERPOLATOR_H
+#define FRAMES_INTERPOLATOR_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Frames {
+
+    /// Ramps every motor linearly from its current output to the newest received target,
+    /// over the interval measured between the last two targets. All math is fixed point.
+    class Interpolator {
+    public:
+        /// @brief Starts a ramp from `current` to `target`.
+        /// @param target the newly received motor values
+        /// @param current the values currently being output, the ramp starts here
+        /// @param count number of motors in both arrays
+        /// @param nowUs arrival time of `target`
+        /// @param maxRampUs longest ramp allowed, slower host rates are not stretched past this
+        void setTarget(const uint16_t *target, const uint16_t *current, size_t count, int64_t nowUs, uint32_t maxRampUs);
+
+        /// @brief Writes the ramped values for `nowUs` into `out`, marking changed motors in `dirty`.
+        /// @return whether any value in `out` changed
+        bool step(int64_t nowUs, uint16_t *out, uint32_t *dirty, size_t count);
+
+        /// @brief Whether a ramp is still in progress.
+        bool ramping() const { return active; }
+
+        /// @brief Drops the current ramp, the next target starts fresh.
+        void stop()
+        {
+            active = false;
+            hasLastTarget = false;
+        }
+
+    private:
+        uint16_t from[MAX_MOTORS] = {};
+        uint16_t to[MAX_MOTORS] = {};
+        int64_t startUs = 0;
+        int64_t lastTargetUs = 0;
+        uint32_t durationUs = 0;
+        bool hasLastTarget = false;
+        bool active = false;
+    };
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_INTERPOLATOR_H
@@ -0,0 +1,125 @@
+#include <stdio.h>
+#include <string.h>
+
+#include "latency.h"
+
+namespace Haptics {
+namespace Frames {
+
+    size_t LatencyHistogram::bucketFor(uint32_t us)
+    {
+        if (us < 16)
+            return us;
+
+        // four buckets per power of two
+        uint8_t octave = 31;
+        while (!(us & (1ul << octave)))
+            octave--;
+        const size_t bucket = 16 + (size_t)(octave - 4) * 4 + ((us >> (octave - 2)) & 3);
+        return bucket < BUCKETS ? bucket : BUCKETS - 1;
+    }
+
+    uint32_t LatencyHistogram::bucketUpperUs(size_t bucket)
+    {
+        if (bucket < 16)
+            return (uint32_t)bucket;
+
+        const uint8_t octave = (uint8_t)(4 + (bucket - 16) / 4);
+        const uint32_t step = 1ul << (octave - 2);
+        return (uint32_t)(4 + (bucket - 16) % 4) * step + step - 1;
+    }
+
+    void LatencyHistogram::record(uint32_t us)
+    {
+        Window *window = &windows[current];
+        if (window->count >= LATENCY_WINDOW)
+        {
+            // the full window becomes the previous one, the old previous one is dropped
+            current ^= 1;
+            window = &windows[current];
+            memset(window, 0, sizeof(*window));
+        }
+
+        if (window->count == 0 || us < window->minUs)
+            window->minUs = us;
+        if (us > window->maxUs)
+            window->maxUs = us;
+        window->counts[bucketFor(us)]++;
+        window->sumUs += us;
+        window->count++;
+    }
+
+    LatencyHistogram::Summary LatencyHistogram::summary() const
+    {
+        Summary summary = {};
+        uint64_t sumUs = 0;
+        for (const Window &window : windows)
+        {
+            if (window.count == 0)
+                continue;
+            if (summary.count == 0 || window.minUs < summary.minUs)
+                summary.minUs = window.minUs;
+            if (window.maxUs > summary.maxUs)
+                summary.maxUs = window.maxUs;
+            summary.count += window.count;
+            sumUs += window.sumUs;
+        }
+        if (summary.count == 0)
+            return summary;
+        summary.avgUs = (uint32_t)(sumUs / summary.count);
+
+        // first bucket where at least 99% of the samples are at or below it
+        const uint32_t target = summary.count - summary.count / 100;
+        uint32_t seen = 0;
+        for (size_t bucket = 0; bucket < BUCKETS; bucket++)
+        {
+            seen += windows[0].counts[bucket] + windows[1].counts[bucket];
+            if (seen >= target)
+            {
+                const uint32_t upper = bucketUpperUs(bucket);
+                summary.p99Us = upper < summary.maxUs ? upper : summary.maxUs;
+                break;
+            }
+        }
+        return summary;
+    }
+
+    /// @brief Appends one stage as `"name":{...}` to `out`.
+    static size_t formatStage(const char *name, const LatencyHistogram::Summary &s, char *out, size_t outSize)
+    {
+        const int written = snprintf(out, outSize,
+                                     "\"%s\":{\"count\":%lu,\"min_us\":%lu,\"avg_us\":%lu,\"p99_us\":%lu,\"max_us\":%lu}",
+                                     name, (unsigned long)s.count, (unsigned long)s.minUs,
+                                     (unsigned long)s.avgUs, (unsigned long)s.p99Us, (unsigned long)s.maxUs);
+        if (written < 0)
+            return 0;
+        return (size_t)written < outSize ? (size_t)written : outSize - 1;
+    }
+
+    LatencySummary summarise(const LatencyStats &stats)
+    {
+        return {stats.queue.summary(), stats.output.summary(), stats.total.summary()};
+    }
+
+    size_t formatLatency(const LatencySummary &summary, char *out, size_t outSize)
+    {
+        if (outSize < 3)
+            return 0;
+
+        size_t len = 0;
+        out[len++] = '{';
+        len += formatStage("queue", summary.queue, out + len, outSize - len);
+        if (len < outSize - 1)
+            out[len++] = ',';
+        len += formatStage("output", summary.output, out + len, outSize - len);
+        if (len < outSize - 1)
+            out[len++] = ',';
+        len += formatStage("total", summary.total, out + len, outSize - len);
+        if (len < outSize - 1)
+            out[len++] = '}';
+        out[len] = 0;
+        return len;
+    }
+
+} // namespace Frames
+} // namespace Haptics
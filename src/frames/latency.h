@@ -0,0 +1,94 @@
+#ifndef FRAMES_LATENCY_H
+#define FRAMES_LATENCY_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Frames {
+
+    /// Where a frame was when it was timestamped, all from the same microsecond clock.
+    struct FrameTiming {
+        /// @brief When the receive path got the frame, or when a bundled frame was due.
+        int64_t receivedUs;
+        /// @brief Whether the host asked for a `/latency` reply once the frame is output.
+        bool traced;
+        /// @brief Host token echoed back in that reply.
+        uint32_t token;
+    };
+
+    /// A traced frame that reached the motors, waiting for its `/latency` reply.
+    struct LatencyTrace {
+        uint32_t token;
+        int64_t receivedUs;
+        /// @brief Receive to output commit.
+        uint32_t commitUs;
+    };
+
+    /// Log-linear histogram of microsecond durations over the last one to two windows of
+    /// `LATENCY_WINDOW` samples. Buckets are exact below 16us and 25% wide above that.
+    class LatencyHistogram {
+    public:
+        struct Summary {
+            uint32_t count;
+            uint32_t minUs;
+            uint32_t avgUs;
+            /// @brief Upper edge of the bucket holding the 99th percentile.
+            uint32_t p99Us;
+            uint32_t maxUs;
+        };
+
+        /// @brief Adds one sample, starting a new window once the current one is full.
+        void record(uint32_t us);
+
+        /// @brief Summarises the previous and current window together.
+        Summary summary() const;
+
+    private:
+        static constexpr size_t BUCKETS = 96;
+
+        struct Window {
+            uint16_t counts[BUCKETS];
+            uint32_t count;
+            uint32_t minUs;
+            uint32_t maxUs;
+            uint64_t sumUs;
+        };
+
+        static size_t bucketFor(uint32_t us);
+        static uint32_t bucketUpperUs(size_t bucket);
+
+        Window windows[2] = {};
+        uint8_t current = 0;
+    };
+
+    /// Latency of each stage of the motor path.
+    struct LatencyStats {
+        /// @brief Receive to the output path taking the frame.
+        LatencyHistogram queue;
+        /// @brief Output path taking the frame to the motors being written.
+        LatencyHistogram output;
+        /// @brief Receive to the motors being written.
+        LatencyHistogram total;
+    };
+
+    /// Summaries of every stage, what the output path publishes for readers on other tasks.
+    struct LatencySummary {
+        LatencyHistogram::Summary queue;
+        LatencyHistogram::Summary output;
+        LatencyHistogram::Summary total;
+    };
+
+    /// @brief Summarises every stage of `stats`.
+    LatencySummary summarise(const LatencyStats &stats);
+
+    /// @brief Writes `summary` as a JSON object into `out`.
+    /// @return number of characters written, excluding the null terminator
+    size_t formatLatency(const LatencySummary &summary, char *out, size_t outSize);
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_LATENCY_H
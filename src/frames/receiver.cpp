@@ -0,0 +1,172 @@
+#include <string.h>
+
+#include "receiver.h"
+
+namespace Haptics {
+namespace Frames {
+
+    void Receiver::reset(uint8_t motorBits)
+    {
+        sequence.reset();
+        frameStats = {};
+        bits = motorBits;
+        memset(vals, 0, sizeof(vals));
+        // a new host session may come from another host, or a restarted one, with another clock
+        clock.reset();
+    }
+
+    void Receiver::configure(uint16_t motorCount, uint16_t offset, const uint16_t *motorGroups)
+    {
+        motors = motorCount;
+        streamOffset = offset;
+        memcpy(groups, motorGroups, sizeof(groups));
+    }
+
+    Receiver::Outcome Receiver::receivePacket(uint8_t *packet, size_t len, bool shared, int64_t receivedUs, const char *&command, size_t &commandLen)
+    {
+        RawMotorMessage frame;
+        if (parseRawMotorMessage(packet, len, frame))
+            return receive(frame, shared, receivedUs);
+
+        // commands are for one board, never for everyone on the shared stream
+        if (!shared && parseRawCommand(packet, len, command, commandLen))
+            return RECEIVE_COMMAND;
+
+        // counted like any other bad motor frame
+        frameStats.received++;
+        frameStats.malformed++;
+        return RECEIVE_INVALID;
+    }
+
+    Receiver::Outcome Receiver::receive(const RawMotorMessage &frame, bool shared, int64_t receivedUs)
+    {
+        const FrameTiming timing = {receivedUs, frame.hasToken, frame.token};
+
+        // the session decides whether `/h` and `/hb` carry 8 or 16 bits per motor
+        const FrameKind kind = withMotorBits(frame.kind, bits);
+        const uint8_t *payload = frame.payload;
+        size_t len = frame.payloadLen;
+        if (shared)
+        {
+            // cut our own motors out of the combined frame, in place in the packet
+            len = sliceFrame(kind, (uint8_t *)payload, len, streamOffset, motors);
+            // a sparse update that changes none of our motors still keeps the failsafe fed, as a keepalive
+            const bool keepalive = kind == FRAME_SPARSE16 && frame.payloadLen % 4 == 0;
+            if (len == 0 && !keepalive)
+                return RECEIVE_DROPPED;
+        }
+
+        frameStats.received++;
+        if (frame.hasSequence && sequence.check(frame.sequence, frameStats) != SequenceTracker::SEQUENCE_ACCEPT)
+            return RECEIVE_DROPPED;
+
+        if (kind == FRAME_BUNDLE16 || kind == FRAME_BUNDLE8)
+            return scheduleBundle(kind, payload, len, timing);
+        if (kind == FRAME_TIMED16 || kind == FRAME_TIMED8)
+            return scheduleTimed(kind, payload, len, timing);
+
+        // group frames expand onto whatever motors this board put in those groups
+        const size_t decoded = kind == FRAME_GROUP16
+            ? decodeGroup(payload, len, groups, vals, MAX_MOTORS)
+            : decodeFrame(kind, payload, len, vals, MAX_MOTORS);
+        if (decoded == 0 && !isKeepalive(kind, len))
+        {
+            frameStats.malformed++;
+            return RECEIVE_DROPPED;
+        }
+        frameStats.applied++;
+
+        // hand the complete frame to the output path, a keepalive republishes the same values to feed the failsafe
+        if (frames.publish(vals, ++epoch, timing))
+            frameStats.coalesced++;
+        return RECEIVE_OUTPUT;
+    }
+
+    /// @brief Queues every frame of a bundle for release at its playout offset.
+    Receiver::Outcome Receiver::scheduleBundle(FrameKind kind, const uint8_t *payload, size_t len, const FrameTiming &timing)
+    {
+        const bool eightBit = kind == FRAME_BUNDLE8;
+        BundleFrame bundle[MAX_QUEUED_FRAMES];
+        const size_t count = parseBundle(payload, len, bundle, MAX_QUEUED_FRAMES, eightBit ? 1 : 2);
+        if (count == 0)
+        {
+            frameStats.malformed++;
+            return RECEIVE_DROPPED;
+        }
+        frameStats.applied++;
+
+        // offsets are relative to the bundle's arrival
+        const int64_t arrival = timing.receivedUs;
+        const uint32_t bundleEpoch = ++epoch;
+        for (size_t i = 0; i < count; i++)
+        {
+            // each frame builds on the one before it, like consecutive `/hb` frames would
+            decodeFrame(eightBit ? FRAME_BLOB8 : FRAME_BLOB16, bundle[i].payload, bundle[i].payloadLen, vals, MAX_MOTORS);
+
+            ScheduledFrame *slot = playout.reserve();
+            if (!slot)
+            {
+                frameStats.queueOverflow++;
+                continue;
+            }
+            memcpy(slot->frame.vals, vals, sizeof(slot->frame.vals));
+            slot->frame.epoch = bundleEpoch;
+            slot->dueUs = arrival + bundle[i].offsetUs;
+            // bundled frames are late from their due time, not their arrival, only the first one is traced
+            slot->frame.timing = {slot->dueUs, timing.traced && i == 0, timing.token};
+            playout.push();
+        }
+        // the first frame is usually due straight away
+        return RECEIVE_OUTPUT;
+    }
+
+    /// @brief Holds a timed frame until the host time it carries, or outputs it at once if it can't be.
+    Receiver::Outcome Receiver::scheduleTimed(FrameKind kind, const uint8_t *payload, size_t len, const FrameTiming &timing)
+    {
+        uint32_t hostUs;
+        const uint8_t *values;
+        size_t valuesLen;
+        const FrameKind valuesKind = kind == FRAME_TIMED8 ? FRAME_BLOB8 : FRAME_BLOB16;
+        if (!parseTimed(payload, len, hostUs, values, valuesLen) ||
+            decodeFrame(valuesKind, values, valuesLen, vals, MAX_MOTORS) == 0)
+        {
+            frameStats.malformed++;
+            return RECEIVE_DROPPED;
+        }
+        frameStats.applied++;
+
+        // without a clock estimate the frame plays on arrival, like a `/hb` frame
+        int64_t dueUs;
+        const uint32_t frameEpoch = ++epoch;
+        if (clock.toLocal(hostUs, timing.receivedUs, dueUs))
+        {
+            const int64_t leadUs = dueUs - timing.receivedUs;
+            if (leadUs <= 0)
+            {
+                frameStats.late++;
+            }
+            else if (leadUs <= SYNC_MAX_LEAD_US)
+            {
+                ScheduledFrame *slot = playout.reserve();
+                if (!slot)
+                {
+                    frameStats.queueOverflow++;
+                    return RECEIVE_DROPPED;
+                }
+                memcpy(slot->frame.vals, vals, sizeof(slot->frame.vals));
+                slot->frame.epoch = frameEpoch;
+                slot->dueUs = dueUs;
+                // like bundled frames, latency counts from the due time
+                slot->frame.timing = {dueUs, timing.traced, timing.token};
+                playout.push();
+                return RECEIVE_OUTPUT;
+            }
+        }
+
+        if (frames.publish(vals, frameEpoch, timing))
+            frameStats.coalesced++;
+        return RECEIVE_OUTPUT;
+    }
+
+} // namespace Frames
+} // namespace Haptics
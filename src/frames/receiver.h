@@ -0,0 +1,102 @@
+#ifndef FRAMES_RECEIVER_H
+#define FRAMES_RECEIVER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "software_defines.h"
+#include "codec.h"
+#include "sequence.h"
+#include "clock_sync.h"
+#include "frame_buffer.hpp"
+#include "spsc_queue.hpp"
+
+namespace Haptics {
+namespace Frames {
+
+    /// Bundled and timed frames waiting for their playout time.
+    using PlayoutQueue = SpscQueue<ScheduledFrame, MAX_QUEUED_FRAMES>;
+
+    /// The receive side of the board without its transports: packet parsing, sequence checks,
+    /// the session's motor bits, shared stream slicing and decoding, up to the hand-over to
+    /// the output path. Every receive path on the board goes through it, and so do the host
+    /// tests and benchmarks, so they measure what ships.
+    /// Not synchronized, the caller serializes access.
+    class Receiver {
+    public:
+        /// What became of a packet.
+        enum Outcome {
+            /// decoded and handed to the output path, which should be woken
+            RECEIVE_OUTPUT,
+            /// a motor frame, but stale, a duplicate, malformed or with nothing for this board
+            RECEIVE_DROPPED,
+            /// a `COMMAND_ADDRESS` message for the caller to run
+            RECEIVE_COMMAND,
+            /// neither a motor frame nor a command, counted as malformed
+            RECEIVE_INVALID,
+        };
+
+        /// @param frames where complete frames are published for the output path
+        /// @param playout where bundled and timed frames wait for their playout time
+        /// @param clock the motor host's clock, timed frames are scheduled through it
+        Receiver(FrameBuffer &frames, PlayoutQueue &playout, ClockSync &clock)
+            : frames(frames), playout(playout), clock(clock) {}
+
+        /// @brief Starts a new host session: forgets sequence numbers, counters, received values and the host clock.
+        /// @param motorBits bits per motor the session negotiated, 8 or 16
+        void reset(uint8_t motorBits);
+
+        /// @brief Switches to new config values.
+        /// @param motorCount this board's motor count, the size of its shared stream slice
+        /// @param offset first motor of this board's shared stream slice
+        /// @param motorGroups each motor's group mask, `MAX_MOTORS` entries
+        void configure(uint16_t motorCount, uint16_t offset, const uint16_t *motorGroups);
+
+        /// @brief Parses a raw OSC packet and receives the motor frame or command in it.
+        /// @param packet the UDP payload, shared stream frames are sliced in place
+        /// @param len length of `packet`
+        /// @param shared whether it came from the shared stream, commands there are invalid
+        /// @param receivedUs when the packet arrived
+        /// @param command filled with the null terminated command for `RECEIVE_COMMAND`, inside `packet`
+        /// @param commandLen filled with the length of the command
+        Outcome receivePacket(uint8_t *packet, size_t len, bool shared, int64_t receivedUs, const char *&command, size_t &commandLen);
+
+        /// @brief Receives a motor frame a transport already split out of its packet.
+        /// @param frame the frame, a `hasToken` frame gets a `/latency` reply once it reaches the motors
+        /// @param shared whether it came from the shared stream, the payload is then sliced in place
+        /// @param receivedUs when the frame arrived
+        Outcome receive(const RawMotorMessage &frame, bool shared, int64_t receivedUs);
+
+        /// @brief Counters of the current session.
+        const FrameStats &stats() const { return frameStats; }
+
+        /// @brief The latest values decoded, what the next frame builds on.
+        const uint16_t *values() const { return vals; }
+
+        /// @brief Bits per motor negotiated for `/h`, `/hb`, `/hq` and `/ht` frames, 8 or 16.
+        uint8_t motorBits() const { return bits; }
+
+    private:
+        Outcome scheduleBundle(FrameKind kind, const uint8_t *payload, size_t len, const FrameTiming &timing);
+        Outcome scheduleTimed(FrameKind kind, const uint8_t *payload, size_t len, const FrameTiming &timing);
+
+        FrameBuffer &frames;
+        PlayoutQueue &playout;
+        ClockSync &clock;
+
+        FrameStats frameStats = {};
+        SequenceTracker sequence;
+        uint16_t vals[MAX_MOTORS] = {};
+        // receive order of the last accepted frame or bundle, see `MotorFrame::epoch`
+        uint32_t epoch = 0;
+        uint8_t bits = 16;
+
+        uint16_t motors = 0;
+        uint16_t streamOffset = 0;
+        uint16_t groups[MAX_MOTORS] = {};
+    };
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_RECEIVER_H
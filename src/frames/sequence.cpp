@@ -0,0 +1,57 @@
+#include <stdio.h>
+
+#include "sequence.h"
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Frames {
+
+    SequenceTracker::Verdict SequenceTracker::check(uint32_t seq, FrameStats &stats)
+    {
+        if (!hasLast)
+        {
+            hasLast = true;
+            last = seq;
+            return SEQUENCE_ACCEPT;
+        }
+
+        // distance from the last applied frame, wraps cleanly at 2^32
+        const int32_t delta = (int32_t)(seq - last);
+        if (delta == 0)
+        {
+            stats.duplicates++;
+            return SEQUENCE_DUPLICATE;
+        }
+        if (delta < 0 && delta > -SEQUENCE_RESET_WINDOW)
+        {
+            stats.droppedStale++;
+            return SEQUENCE_STALE;
+        }
+
+        // anything further back than the window is a host that restarted its counter
+        if (delta > 1)
+        {
+            stats.gaps++;
+            stats.lost += delta - 1;
+        }
+        last = seq;
+        return SEQUENCE_ACCEPT;
+    }
+
+    size_t formatStats(const FrameStats &stats, char *out, size_t outSize)
+    {
+        const int written = snprintf(out, outSize,
+                                     "{\"received\":%lu,\"applied\":%lu,\"dropped_stale\":%lu,"
+                                     "\"duplicates\":%lu,\"gaps\":%lu,\"lost\":%lu,\"malformed\":%lu,\"coalesced\":%lu,\"queue_overflow\":%lu,\"late\":%lu}",
+                                     (unsigned long)stats.received, (unsigned long)stats.applied,
+                                     (unsigned long)stats.droppedStale, (unsigned long)stats.duplicates,
+                                     (unsigned long)stats.gaps, (unsigned long)stats.lost,
+                                     (unsigned long)stats.malformed, (unsigned long)stats.coalesced,
+                                     (unsigned long)stats.queueOverflow, (unsigned long)stats.late);
+        if (written < 0)
+            return 0;
+        return (size_t)written < outSize ? (size_t)written : outSize - 1;
+    }
+
+} // namespace Frames
+} // namespace Haptics
@@ -0,0 +1,64 @@
+#ifndef FRAMES_SEQUENCE_H
+#define FRAMES_SEQUENCE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+namespace Haptics {
+namespace Frames {
+
+    /// Per-session motor frame counters, reset whenever a host pings us.
+    struct FrameStats {
+        /// @brief Motor frames that reached a callback, valid or not.
+        uint32_t received;
+        /// @brief Frames that were decoded and published to the output path.
+        uint32_t applied;
+        /// @brief Frames discarded because a newer frame was already applied.
+        uint32_t droppedStale;
+        /// @brief Frames discarded because their sequence number was already applied.
+        uint32_t duplicates;
+        /// @brief Times a jump in sequence numbers was seen.
+        uint32_t gaps;
+        /// @brief Sum of the frames skipped over by those jumps.
+        uint32_t lost;
+        /// @brief Frames rejected by the decoders.
+        uint32_t malformed;
+        /// @brief Applied frames that were replaced by a newer one before the output path took them.
+        uint32_t coalesced;
+        /// @brief Bundled frames dropped because the playout queue was full.
+        uint32_t queueOverflow;
+        /// @brief Timed frames that arrived after the time they were due, output at once.
+        uint32_t late;
+    };
+
+    /// Rejects motor frames that arrive out of order, using wrapping 32-bit sequence numbers.
+    class SequenceTracker {
+    public:
+        enum Verdict {
+            SEQUENCE_ACCEPT,
+            SEQUENCE_STALE,
+            SEQUENCE_DUPLICATE,
+        };
+
+        /// @brief Checks a sequence number against the last accepted one, updating `stats`.
+        /// @param seq the frame's sequence number
+        /// @param stats counters to record stale, duplicate and gap events in
+        /// @return whether the frame should be applied
+        Verdict check(uint32_t seq, FrameStats &stats);
+
+        /// @brief Forgets the last sequence number, the next frame is always accepted.
+        void reset() { hasLast = false; }
+
+    private:
+        bool hasLast = false;
+        uint32_t last = 0;
+    };
+
+    /// @brief Writes `stats` as a JSON object into `out`.
+    /// @return number of characters written, excluding the null terminator
+    size_t formatStats(const FrameStats &stats, char *out, size_t outSize);
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_SEQUENCE_H
@@ -0,0 +1,86 @@
+#include "serial_framer.h"
+#include "cobs.h"
+
+namespace Haptics {
+namespace Frames {
+
+    SerialFramer::Event SerialFramer::push(uint8_t c)
+    {
+        if (inFrame)
+            return frameByte(c);
+        if (c != 0)
+            return lineByte(c);
+
+        // a frame can't be part of a command, whatever text came before it is dropped
+        inFrame = true;
+        lineLen = 0;
+        lineEndsCR = false;
+        lineOverflow = false;
+        lineSynced = false;
+        return SERIAL_LINE_RESET;
+    }
+
+    void SerialFramer::pause()
+    {
+        if (!inFrame && lineLen == 0 && !lineOverflow)
+            lineSynced = true;
+    }
+
+    /// @brief Collects one byte of a text command, the line is complete at its newline.
+    SerialFramer::Event SerialFramer::lineByte(uint8_t c)
+    {
+        if (c == '\n')
+        {
+            // only the line ending counts, `UPLOAD CHUNK` payloads keep their own whitespace
+            const size_t contentLen = lineLen - (lineEndsCR ? 1 : 0);
+            Event event = SERIAL_NONE;
+            if (lineOverflow)
+                event = SERIAL_LINE_TOO_LONG;
+            else if (contentLen > 0)
+                event = lineSynced ? SERIAL_LINE_READY : SERIAL_LINE_UNSYNCED;
+            lineLen = 0;
+            lineEndsCR = false;
+            lineOverflow = false;
+            lineSynced = true;
+            return event;
+        }
+
+        if (lineOverflow)
+            return SERIAL_NONE;
+        if (lineLen >= SERIAL_LINE_MAX)
+        {
+            lineOverflow = true;
+            lineLen = 0;
+            return SERIAL_LINE_RESET;
+        }
+        lineLen++;
+        lineEndsCR = c == '\r';
+        return SERIAL_LINE_CHAR;
+    }
+
+    /// @brief Collects one byte of a binary frame, decoding it at the closing delimiter.
+    SerialFramer::Event SerialFramer::frameByte(uint8_t c)
+    {
+        if (c != 0)
+        {
+            if (frameLen < capacity)
+                buffer[frameLen++] = c;
+            else
+                frameOverflow = true;
+            return SERIAL_NONE;
+        }
+
+        // back to back delimiters just open the frame again
+        if (frameLen == 0 && !frameOverflow)
+            return SERIAL_NONE;
+
+        decodedLen = frameOverflow ? 0 : cobsDecode(buffer, frameLen, buffer);
+        inFrame = false;
+        frameLen = 0;
+        frameOverflow = false;
+        lineSynced = true;
+        return SERIAL_FRAME;
+    }
+
+} // namespace Frames
+} // namespace Haptics
@@ -0,0 +1,73 @@
+#ifndef FRAMES_SERIAL_FRAMER_H
+#define FRAMES_SERIAL_FRAMER_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Frames {
+
+    /// Splits the serial byte stream into text command lines and COBS binary frames. Text never
+    /// contains 0x00, so a 0x00 opens a frame and the next 0x00 after some data closes it again.
+    ///
+    /// A line is only submitted if it began at a clean line start: after a newline, a frame or a
+    /// pause in the input. Until then its bytes may be the tail of a frame we joined halfway.
+    /// The framer only keeps state, the caller collects the line's characters.
+    class SerialFramer {
+    public:
+        /// What the caller does after a byte.
+        enum Event {
+            /// nothing
+            SERIAL_NONE,
+            /// appends the byte to the line
+            SERIAL_LINE_CHAR,
+            /// drops the characters collected so far, a frame started or the line got too long
+            SERIAL_LINE_RESET,
+            /// the line is complete, submits it without its trailing '\r' and starts a new one
+            SERIAL_LINE_READY,
+            /// a line longer than `SERIAL_LINE_MAX` ended, starts a new one
+            SERIAL_LINE_TOO_LONG,
+            /// a line that began mid-line ended, drops it and starts a new one
+            SERIAL_LINE_UNSYNCED,
+            /// a frame closed, `frameLength()` bytes of its packet are in the frame buffer.
+            /// An oversized or corrupt frame decodes to 0 bytes, and is still handed on to be counted
+            SERIAL_FRAME,
+        };
+
+        /// @param buffer where frames are collected and decoded, a frame that doesn't fit is dropped
+        /// @param capacity size of `buffer`
+        SerialFramer(uint8_t *buffer, size_t capacity) : buffer(buffer), capacity(capacity) {}
+
+        /// @brief Takes the next byte of the stream.
+        Event push(uint8_t c);
+
+        /// @brief New bytes arrived after `SERIAL_SYNC_IDLE_MS` without input, the next line starts clean.
+        /// A streaming host never pauses mid frame, someone typing a command does before it.
+        void pause();
+
+        /// @brief Length of the packet the last `SERIAL_FRAME` decoded.
+        size_t frameLength() const { return decodedLen; }
+
+    private:
+        Event lineByte(uint8_t c);
+        Event frameByte(uint8_t c);
+
+        uint8_t *buffer;
+        size_t capacity;
+        size_t frameLen = 0;
+        size_t decodedLen = 0;
+        bool inFrame = false;
+        bool frameOverflow = false;
+
+        size_t lineLen = 0;
+        bool lineEndsCR = false;
+        bool lineOverflow = false;
+        bool lineSynced = false;
+    };
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_SERIAL_FRAMER_H
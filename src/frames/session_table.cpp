@@ -0,0 +1,86 @@
+#include "session_table.h"
+
+namespace Haptics {
+namespace Frames {
+
+    Session *SessionTable::open(uint32_t ip, uint16_t sourcePort, uint16_t port, unsigned long now, Session &previous)
+    {
+        Session *slot = nullptr;
+        for (Session &session : sessions)
+        {
+            // the host pings again, or restarted and pings from a new port, either way it keeps its slot
+            if (session.active && session.ip == ip)
+            {
+                slot = &session;
+                break;
+            }
+            if (!slot || (slot->active && (!session.active || session.lastSeenMs < slot->lastSeenMs)))
+                slot = &session;
+        }
+
+        previous = *slot;
+        // frames from the old socket don't make the new one the motor host
+        if (!slot->active || slot->ip != ip || slot->sourcePort != sourcePort)
+            slot->lastFrameMs = 0;
+        slot->active = true;
+        slot->ip = ip;
+        slot->sourcePort = sourcePort;
+        slot->port = port;
+        slot->lastSeenMs = now;
+        return slot;
+    }
+
+    Session *SessionTable::find(uint32_t ip)
+    {
+        for (Session &session : sessions)
+        {
+            if (session.active && session.ip == ip)
+                return &session;
+        }
+        return nullptr;
+    }
+
+    void SessionTable::noteActivity(uint32_t ip, bool motorFrame, unsigned long now)
+    {
+        Session *session = find(ip);
+        if (!session)
+            return;
+        session->lastSeenMs = now;
+        if (motorFrame)
+            session->lastFrameMs = now;
+    }
+
+    bool SessionTable::otherHostStreaming(uint32_t ip, unsigned long now) const
+    {
+        for (const Session &session : sessions)
+        {
+            if (!session.active || session.ip == ip)
+                continue;
+            if (session.lastFrameMs != 0 && now - session.lastFrameMs < SESSION_TIMEOUT_MS)
+                return true;
+        }
+        return false;
+    }
+
+    const Session *SessionTable::motorSession() const
+    {
+        const Session *latest = nullptr;
+        for (const Session &session : sessions)
+        {
+            if (session.active && session.lastFrameMs != 0 && (!latest || session.lastFrameMs > latest->lastFrameMs))
+                latest = &session;
+        }
+        return latest;
+    }
+
+    void SessionTable::expire(unsigned long now)
+    {
+        for (Session &session : sessions)
+        {
+            if (expired(session, now))
+                session.active = false;
+        }
+    }
+
+} // namespace Frames
+} // namespace Haptics
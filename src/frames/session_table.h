@@ -0,0 +1,70 @@
+#ifndef FRAMES_SESSION_TABLE_H
+#define FRAMES_SESSION_TABLE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "software_defines.h"
+
+namespace Haptics {
+namespace Frames {
+
+    /// A host that pinged us, e.g. the game driving the motors or a monitoring tool.
+    struct Session {
+        bool active;
+        /// @brief IPv4 address of the host, one session per address.
+        uint32_t ip;
+        /// @brief Port the host last pinged from.
+        uint16_t sourcePort;
+        /// @brief Port the host asked us to reply to.
+        uint16_t port;
+        unsigned long lastSeenMs;
+        /// @brief Last motor frame from this host, 0 if it never sent one.
+        unsigned long lastFrameMs;
+    };
+
+    /// The hosts we talk to. A host keeps its session while it sends anything, and loses it
+    /// after `SESSION_TIMEOUT_MS` of silence. A ping from an address that already has a
+    /// session replaces it: a restarted host pings from a new port, and its old session
+    /// must not keep looking like another host streaming.
+    /// Not synchronized, the caller serializes access.
+    class SessionTable {
+    public:
+        /// @brief Finds or adds the session for a pinging host, evicting the quietest one if the table is full.
+        /// @param sourcePort port the ping was sent from
+        /// @param port port the host asked us to reply to
+        /// @param previous filled with what the slot held before, to tell a new host from a returning one
+        Session *open(uint32_t ip, uint16_t sourcePort, uint16_t port, unsigned long now, Session &previous);
+
+        /// @brief Active session of the host at `ip`, nullptr if it never pinged or went silent.
+        Session *find(uint32_t ip);
+
+        /// @brief Keeps the host's session alive, `motorFrame` also marks it as the one driving the motors.
+        void noteActivity(uint32_t ip, bool motorFrame, unsigned long now);
+
+        /// @brief Whether a host at another address than `ip` sent motor frames within the session timeout.
+        bool otherHostStreaming(uint32_t ip, unsigned long now) const;
+
+        /// @brief The session that most recently sent a motor frame, nullptr if none did.
+        const Session *motorSession() const;
+
+        /// @brief Whether `session` has been silent for `SESSION_TIMEOUT_MS`.
+        bool expired(const Session &session, unsigned long now) const
+        {
+            return session.active && now - session.lastSeenMs >= SESSION_TIMEOUT_MS;
+        }
+
+        /// @brief Drops every expired session.
+        void expire(unsigned long now);
+
+        const Session *begin() const { return sessions; }
+        const Session *end() const { return sessions + MAX_SESSIONS; }
+
+    private:
+        Session sessions[MAX_SESSIONS] = {};
+    };
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_SESSION_TABLE_H
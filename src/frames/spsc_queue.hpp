@@ -0,0 +1,52 @@
+#ifndef FRAMES_SPSC_QUEUE_HPP
+#define FRAMES_SPSC_QUEUE_HPP
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "atomic_index.hpp"
+
+namespace Haptics {
+namespace Frames {
+
+    /// Bounded lock-free FIFO between exactly one producer and one consumer.
+    /// Items are written and read in place, nothing is allocated.
+    template <typename T, uint16_t N>
+    class SpscQueue {
+        static_assert(N > 0 && (N & (N - 1)) == 0, "queue capacity must be a power of two");
+
+    public:
+        /// @brief Producer: slot to fill before `push`, or nullptr if the queue is full.
+        T *reserve()
+        {
+            const uint16_t tail = writeIndex.load();
+            if ((uint16_t)(tail - readIndex.load()) >= N)
+                return nullptr;
+            return &items[tail % N];
+        }
+
+        /// @brief Producer: makes the slot returned by `reserve` visible to the consumer.
+        void push() { writeIndex.store(writeIndex.load() + 1); }
+
+        /// @brief Consumer: oldest item, or nullptr if the queue is empty.
+        const T *peek() const
+        {
+            const uint16_t head = readIndex.load();
+            if (head == writeIndex.load())
+                return nullptr;
+            return &items[head % N];
+        }
+
+        /// @brief Consumer: releases the item returned by `peek`.
+        void pop() { readIndex.store(readIndex.load() + 1); }
+
+    private:
+        T items[N] = {};
+        AtomicIndex<uint16_t> writeIndex{0}; // only stored by the producer
+        AtomicIndex<uint16_t> readIndex{0};  // only stored by the consumer
+    };
+
+} // namespace Frames
+} // namespace Haptics
+
+#endif // FRAMES_SPSC_QUEUE_HPP
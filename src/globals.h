@@ -3,6 +3,11 @@
 
 #include "Arduino.h"
 #include "software_defines.h"
+#include "frames/frame_buffer.hpp"
+#include "frames/spsc_queue.hpp"
+#include "frames/latency.h"
+#include "frames/clock_sync.h"
+#include "frames/receiver.h"
 
 namespace Haptics {
     extern volatile unsigned long lastPacketMs;
@@ -12,27 +17,26 @@ namespace Haptics {
     struct Globals {
         uint8_t ledcMotorVals[MAX_LEDC_MOTORS];
         uint16_t pcaMotorVals[MAX_I2C_MOTORS];
+        // motor values currently being output, only the output path writes these
         uint16_t allMotorVals[MAX_MOTORS];
+        // motors in `allMotorVals` that changed since `updateMotorVals` last ran
+        uint32_t dirtyMotors[MOTOR_BITMAP_WORDS];
         // Duration bump has been active
         int64_t bumpActivateTime[MAX_MOTORS];
         // whether bump has been triggered since value was last zero.
         bool bumpSinceZero[MAX_MOTORS];
         bool updatedMotors;
         bool reinitLEDC;
-        bool processOscCommand; // moves the heavy commands out of ISR time
-        bool processSerCommand;
         bool beenPinged;
-        String commandToProcess;
         bool messageRecieved;
+        // receive order of the frame currently being output, see `Frames::MotorFrame::epoch`
+        uint32_t outputEpoch;
     };
 
     inline Globals initGlobals() {
         Globals g = {};
         g.reinitLEDC = false;
         g.updatedMotors = false;
-        g.processOscCommand = false;
-        g.processSerCommand = false;
-        g.commandToProcess = "";
         g.beenPinged = false;
         g.messageRecieved = false;
         return g;
@@ -48,6 +52,26 @@ namespace Haptics {
 
     // Declare a global instance of Globals.
     inline Globals globals = initGlobals();
+
+    // Hands complete motor frames from the receive path to the output path.
+    inline Frames::FrameBuffer motorFrames;
+    // Bundled frames waiting for their playout time, released by the output path.
+    inline Frames::SpscQueue<Frames::ScheduledFrame, MAX_QUEUED_FRAMES> scheduledFrames;
+    // Traced frames that reached the motors, replied to from the network side.
+    inline Frames::SpscQueue<Frames::LatencyTrace, MAX_LATENCY_TRACES> latencyTraces;
+    // The motor host's clock, used to play `MOTOR_TIMED_ADDRESS` frames at the same time on every board.
+    inline Frames::ClockSync clockSync;
+    // Decodes motor frames from every receive path, only used under `Wireless::ReceiveLock`.
+    inline Frames::Receiver motorReceiver{motorFrames, scheduledFrames, clockSync};
+
+    /// @brief Microsecond timestamp that doesn't wrap, on both platforms.
+    inline int64_t nowMicros() {
+#if defined(ESP8266)
+        return (int64_t)micros64();
+#else
+        return esp_timer_get_time();
+#endif
+    }
 } // namespace Haptics
 
 #endif // GLOBALS_H
\ No newline at end of file
@@ -20,9 +20,13 @@
 // import modules
 #include "wifi/osc.h"
 #include "wifi/callbacks.h"
+#include "wifi/fast_path.h"
 #include "PWM/PCA/pca.h"
 #include "PWM/LEDC/ledc.h"
 #include "serial/serial.h"
+#include "pipeline/pipeline.h"
+#include "telemetry/telemetry.h"
+#include "transport/transport.h"
 
 // testing
 #include "testing/rampPWM.hpp"
@@ -33,7 +37,10 @@ Haptics::Logging::Logger logger("Main");
 
 void setup()
 {
+	// before begin(), the buffer can't be resized afterwards
+	Serial.setRxBufferSize(SERIAL_RX_BUFFER_SIZE);
 	Serial.begin(115200);
+	Haptics::Transport::add(&Haptics::SerialComm::serialTransport);
 
 #ifdef DEV_MODE
 	// wait for serial if we are developing
@@ -55,13 +62,20 @@ void setup()
 	}
 #endif
 
+	const unsigned long configStart = micros();
 	Haptics::Conf::loadConfig();
+	logger.debug("Config loaded in %lu us", micros() - configStart);
 	Haptics::initGlobals();
 
+	// before the receive task starts decoding frames
+	Haptics::Wireless::applyReceiveConfig(Haptics::Conf::conf);
 	Haptics::Wireless::Start(&Haptics::Conf::conf);
 	OTA::otaSetup(OTA_PASS);
 	Haptics::PCA::start(&Haptics::Conf::conf);
-	Haptics::LEDC::start(&Haptics::Conf::conf);
+	// from here on only the output pipeline touches the motors, it starts LEDC on its first pass
+	Haptics::Pipeline::applyConfig(Haptics::Conf::conf);
+	Haptics::Pipeline::post(Haptics::Pipeline::CONTROL_REINIT_LEDC);
+	Haptics::Pipeline::start();
 }
 
 void enterLimp()
@@ -113,6 +127,7 @@ void enterLimp()
 uint32_t ticks = 0;
 time_t now = 0;
 time_t lastSerialPush = millis();
+time_t lastBroadcast = 0;
 time_t lastWifiTick = millis();
 time_t lastOtaTick = millis();
 
@@ -131,45 +146,19 @@ void loop()
 	}
 
 	if (Haptics::globals.reinitLEDC)
-	{ // prevents not defined error
-		Haptics::LEDC::start(&Haptics::Conf::conf);
-		logger.debug("Restarted LEDC");
+	{ // the output path owns LEDC, it restarts it on its next pass
+		Haptics::Pipeline::post(Haptics::Pipeline::CONTROL_REINIT_LEDC);
 		Haptics::globals.reinitLEDC = false;
 	}
 
-	Haptics::PCA::setPcaDuty(&Haptics::globals, &Haptics::Conf::conf);
-	Haptics::SerialComm::tick();
+	// serial, and on the ESP8266 the fast path and stream, which aren't held back by the OSC tick below
+	Haptics::Transport::pollAll();
 
-	// Moves heavy lifting out of ISR's
-	if (Haptics::globals.updatedMotors)
-	{
-		Haptics::globals.updatedMotors = false;
-		Haptics::Wireless::updateMotorVals();
-		#ifdef ESP8266
-		Haptics::LEDC::tick(); // only needed on esp8266
-		#endif
-	}
+	// take the newest received frame out to the motors (no-op if it has its own task)
+	Haptics::Pipeline::tick();
 
-	// Handle commands (like changing the config, not setting motor values.)
-	if (Haptics::globals.processOscCommand)
-	{
-		// if we were sent a command over OSC
-		messageRecieved = true;
-		const String response = Haptics::Conf::Parser::parseInput(Haptics::globals.commandToProcess);
-		OscMessage commandResponse(COMMAND_ADDRESS);
-		commandResponse.pushString(response);
-		Haptics::Wireless::oscClient.send(Haptics::Wireless::hostIP, Haptics::Wireless::sendPort, commandResponse);
-		Haptics::globals.commandToProcess = "";
-		Haptics::globals.processOscCommand = false;
-	}
-	else if (Haptics::globals.processSerCommand)
-	{
-		// If we were sent a command over serial
-		String response = Haptics::Conf::Parser::parseInput(Haptics::globals.commandToProcess);
-		Serial.println(response);
-		Haptics::globals.commandToProcess = "";
-		Haptics::globals.processSerCommand = false;
-	}
+	// Handle commands (like changing the config, not setting motor values.) from whichever transport sent them
+	Haptics::Transport::processCommand();
 
 	ticks += 1;
 	now = millis();
@@ -182,6 +171,7 @@ void loop()
 	if (now - lastSerialPush >= 1000)
 	{
 		logger.debug("Loop/sec: %d", ticks);
+		Haptics::Telemetry::setLoopRate(ticks);
 		Haptics::Wireless::printMetrics();
 		Haptics::PwmUtils::printAllDuty();
 
@@ -189,6 +179,7 @@ void loop()
 		// ESP32 has temperature sensor
 		float temp = temperatureRead();
 		logger.debug("Temp: %.2f °C", temp);
+		Haptics::Telemetry::setTemperature(temp);
 		if (temp >= MAX_TEMP)
 		{
 			enterLimp();
@@ -196,14 +187,12 @@ void loop()
 #endif
 
 		// we should recieve atleast one message over a second if we are connected/
-		// if we arent connected we should broadcast each second
-		if (now - Haptics::lastPacketMs > 1000)
+		// if we arent connected hosts find us through mDNS, the broadcast is only for older ones.
+		// The output pipeline's failsafe already stopped the motors by now.
+		if (now - Haptics::lastPacketMs > 1000 && now - lastBroadcast >= BROADCAST_PERIOD_MS)
 		{
-			// Reset all motors to zero if we don't have a connection.
-			for (uint16_t i = 0; i < MAX_MOTORS; i++) {
-				Haptics::globals.allMotorVals[i] = 0;
-			}
 			Haptics::Wireless::Broadcast();
+			lastBroadcast = now;
 		}
 
 		lastSerialPush = now;
@@ -0,0 +1,253 @@
+#include "pipeline.h"
+#include "globals.h"
+#include "config/config.h"
+#include "frames/interpolator.h"
+#include "frames/failsafe.h"
+#include "wifi/callbacks.h"
+#include "PWM/LEDC/ledc.h"
+#include "PWM/PCA/pca.h"
+#include "logging/Logger.h"
+
+namespace Haptics {
+namespace Pipeline {
+
+    Logging::Logger logger("Pipeline");
+
+    static Frames::Interpolator interpolator;
+    static int64_t lastInterpolationUs = 0;
+    static Frames::Failsafe failsafe;
+    static int64_t lastFailsafeUs = 0;
+    // loop() is the only producer, the output path the only consumer
+    static Frames::SpscQueue<ControlEvent, MAX_CONTROL_EVENTS> controlEvents;
+    static Frames::TripleBuffer<Conf::OutputConfig> outputConfigs;
+
+    // only the output path records, loop() reads the summaries it publishes
+    static Frames::LatencyStats latencyStats;
+    static Frames::TripleBuffer<Frames::LatencySummary> latencySummaries;
+    static int64_t lastLatencyPublishUs = 0;
+    static bool latencyRecorded = false;
+
+    // the newest frame taken this pass, timed once it reaches the motors
+    static Frames::FrameTiming pendingTiming;
+    static int64_t pendingTakenUs = 0;
+    static bool pendingCommit = false;
+    // every traced frame taken this pass, a newer frame in the same pass mustn't swallow its reply
+    static Frames::FrameTiming pendingTraces[MAX_LATENCY_TRACES];
+    static size_t pendingTraceCount = 0;
+
+    /// @brief Microseconds from `fromUs` to `toUs`, 0 if `toUs` is earlier (a bundled frame released early).
+    static uint32_t elapsedUs(int64_t fromUs, int64_t toUs)
+    {
+        return toUs > fromUs ? (uint32_t)(toUs - fromUs) : 0;
+    }
+
+    /// @brief Records how long the frame taken this pass took to reach the motors.
+    static void commitLatency()
+    {
+        const int64_t committedUs = nowMicros();
+        latencyStats.output.record(elapsedUs(pendingTakenUs, committedUs));
+        latencyStats.total.record(elapsedUs(pendingTiming.receivedUs, committedUs));
+        pendingCommit = false;
+        latencyRecorded = true;
+
+        for (size_t i = 0; i < pendingTraceCount; i++)
+        {
+            // replies go out from the network side, a full queue skips the rest
+            Frames::LatencyTrace *trace = latencyTraces.reserve();
+            if (!trace)
+                break;
+            *trace = {pendingTraces[i].token, pendingTraces[i].receivedUs, elapsedUs(pendingTraces[i].receivedUs, committedUs)};
+            latencyTraces.push();
+        }
+        pendingTraceCount = 0;
+    }
+
+    /// @brief Hands a received frame to the interpolator or straight to `allMotorVals`,
+    /// unless a newer frame was already output.
+    static bool takeFrame(const Frames::MotorFrame &frame, int64_t now)
+    {
+        if ((int32_t)(frame.epoch - globals.outputEpoch) < 0)
+            return false;
+        globals.outputEpoch = frame.epoch;
+        failsafe.feed(now);
+
+        latencyStats.queue.record(elapsedUs(frame.timing.receivedUs, now));
+        pendingTiming = frame.timing;
+        pendingTakenUs = now;
+        pendingCommit = true;
+        if (frame.timing.traced && pendingTraceCount < MAX_LATENCY_TRACES)
+            pendingTraces[pendingTraceCount++] = frame.timing;
+
+        if (config().interp_enabled)
+        {
+            interpolator.setTarget(frame.vals, globals.allMotorVals, MAX_MOTORS, now, config().interp_max_ramp_us);
+            return true;
+        }
+
+        // only changed motors need another pass through the bump logic
+        if (Frames::copyChanged(frame.vals, globals.allMotorVals, globals.dirtyMotors, MAX_MOTORS))
+            globals.updatedMotors = true;
+        return true;
+    }
+
+    /// @brief Takes due bundle frames and the newest published frame.
+    static void consumeFrames(int64_t now)
+    {
+        // release queued bundle frames whose playout time has come, oldest first
+        while (const Frames::ScheduledFrame *scheduled = scheduledFrames.peek())
+        {
+            if (scheduled->dueUs > now)
+                break;
+            takeFrame(scheduled->frame, now);
+            scheduledFrames.pop();
+        }
+
+        if (const Frames::MotorFrame *frame = motorFrames.acquire())
+            takeFrame(*frame, now);
+    }
+
+    /// @brief Runs every control event posted since the last pass.
+    static void consumeControlEvents()
+    {
+        while (const ControlEvent *event = controlEvents.peek())
+        {
+            switch (*event)
+            {
+            case CONTROL_APPLY_CONFIG:
+                // nullptr if an earlier event already took the newest copy
+                outputConfigs.acquire();
+                break;
+            case CONTROL_REINIT_LEDC:
+                LEDC::start(&config());
+                logger.debug("Started LEDC");
+                break;
+            }
+            controlEvents.pop();
+        }
+    }
+
+    /// @brief One pass of the output path, from the loop or the output task.
+    static void run()
+    {
+        consumeControlEvents();
+
+        const int64_t now = nowMicros();
+        consumeFrames(now);
+
+        // ramps advance at a fixed rate, independent of how often frames arrive
+        if (interpolator.ramping() && now - lastInterpolationUs >= INTERP_PERIOD_US)
+        {
+            lastInterpolationUs = now;
+            if (interpolator.step(now, globals.allMotorVals, globals.dirtyMotors, MAX_MOTORS))
+                globals.updatedMotors = true;
+        }
+
+        // the watchdog runs every millisecond, holding then fading the motors once frames stop
+        if (now - lastFailsafeUs >= FAILSAFE_PERIOD_US)
+        {
+            lastFailsafeUs = now;
+            if (failsafe.update(now, config().failsafe_hold_ms * 1000u, config().failsafe_fade_ms * 1000u,
+                                globals.allMotorVals, globals.dirtyMotors, MAX_MOTORS))
+            {
+                // a ramp would fight the fade
+                interpolator.stop();
+                globals.updatedMotors = true;
+            }
+        }
+
+        // Moves heavy lifting out of ISR's
+        if (globals.updatedMotors)
+        {
+            globals.updatedMotors = false;
+            Wireless::updateMotorVals();
+#ifdef ESP8266
+            LEDC::tick(); // only needed on esp8266
+#endif
+        }
+
+        PCA::setPcaDuty(&globals, &config());
+
+        if (pendingCommit)
+            commitLatency();
+
+        // summarising walks every bucket, so readers get a copy a few times a second instead of every frame
+        if (latencyRecorded && now - lastLatencyPublishUs >= LATENCY_PUBLISH_PERIOD_US)
+        {
+            lastLatencyPublishUs = now;
+            latencyRecorded = false;
+            latencySummaries.back() = Frames::summarise(latencyStats);
+            latencySummaries.publish();
+        }
+    }
+
+#ifdef PIPELINE_TASK
+    static TaskHandle_t pipelineTaskHandle = nullptr;
+
+    static void pipelineTask(void *)
+    {
+        for (;;)
+        {
+            run();
+            // sleep until a frame is published, or one tick (1ms) so ramps and bundles keep time
+            ulTaskNotifyTake(pdTRUE, 1);
+        }
+    }
+
+    void start()
+    {
+        if (pipelineTaskHandle)
+            return;
+
+        xTaskCreatePinnedToCore(pipelineTask, "pipeline", PIPELINE_TASK_STACK, nullptr,
+                                PIPELINE_TASK_PRIORITY, &pipelineTaskHandle, PIPELINE_TASK_CORE);
+        logger.debug("Output pipeline running on core %d", PIPELINE_TASK_CORE);
+    }
+
+    void tick() {}
+
+    void notify()
+    {
+        if (pipelineTaskHandle)
+            xTaskNotifyGive(pipelineTaskHandle);
+    }
+#else
+    void start() {}
+
+    void tick() { run(); }
+
+    void notify() {}
+#endif
+
+    bool post(ControlEvent event)
+    {
+        ControlEvent *slot = controlEvents.reserve();
+        if (!slot)
+        {
+            logger.warn("Control queue full, dropped event %d", event);
+            return false;
+        }
+        *slot = event;
+        controlEvents.push();
+        return true;
+    }
+
+    void applyConfig(const Conf::Config &conf)
+    {
+        Conf::copyOutputConfig(conf, outputConfigs.back());
+        outputConfigs.publish();
+        post(CONTROL_APPLY_CONFIG);
+    }
+
+    const Conf::OutputConfig &config()
+    {
+        return outputConfigs.front();
+    }
+
+    const Frames::LatencySummary &latency()
+    {
+        latencySummaries.acquire();
+        return latencySummaries.front();
+    }
+
+} // namespace Pipeline
+} // namespace Haptics
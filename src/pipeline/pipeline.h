@@ -0,0 +1,55 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <Arduino.h>
+
+#include "config/config.h"
+#include "frames/latency.h"
+
+// Dual core ESP32s run the output pipeline in its own task on the core WiFi doesn't use.
+// The C3 and ESP8266 only have one core and keep calling it from loop().
+#if !defined(ESP8266) && !defined(CONFIG_FREERTOS_UNICORE)
+#define PIPELINE_TASK 1
+#endif
+
+namespace Haptics {
+namespace Pipeline {
+
+    /// The output side of the motor path: takes frames published by the receive path,
+    /// optionally interpolates between them, and pushes the result to the motors.
+    /// It is the only code that touches LEDC and the PCA boards once running.
+
+    /// @brief Requests the output path does, in order, on its next pass.
+    enum ControlEvent : uint8_t {
+        CONTROL_APPLY_CONFIG, // switch to the config copy handed over by `applyConfig`
+        CONTROL_REINIT_LEDC,  // re-read the LEDC pin map and restart the channels
+    };
+
+    /// @brief Starts the output task on dual core boards, call once the motors are set up.
+    void start();
+
+    /// @brief Runs one pass of the output pipeline from loop().
+    /// Does nothing when the pipeline has its own task.
+    void tick();
+
+    /// @brief Wakes the output task after a frame was published, so it doesn't wait for its next pass.
+    void notify();
+
+    /// @brief Queues a control event for the output path. Only call from loop().
+    /// @return false if the queue is full and the event was dropped
+    bool post(ControlEvent event);
+
+    /// @brief Hands the output path a copy of the fields it reads from `conf`, applied on its next pass.
+    /// Call from loop() after anything that may have changed `conf`.
+    void applyConfig(const Conf::Config &conf);
+
+    /// @brief The output path's own copy of the config. Only read it from the output path.
+    const Conf::OutputConfig &config();
+
+    /// @brief Newest per-stage latency summary the output path published. Only call from loop().
+    const Frames::LatencySummary &latency();
+
+} // namespace Pipeline
+} // namespace Haptics
+
+#endif // PIPELINE_H
@@ -5,38 +5,79 @@
 #include "board_defines.h"  // Provides board-specific defines
 #include "PWM/LEDC/ledc.h"
 #include "wifi/callbacks.h"
+#include "frames/cobs.h"
+#include "frames/serial_framer.h"
 #include <Arduino.h>
 
-// Helper function to trim leading/trailing whitespace from a String.
-static String trim(const String &str) {
-  unsigned int start = 0;
-  while (start < str.length() && isspace(str.charAt(start)))
-    start++;
-  unsigned int end = str.length() - 1;
-  while (end >= 0 && isspace(str.charAt(end)))
-    end--;
-  return (end >= start) ? str.substring(start, end + 1) : "";
-}
-
-
-
 namespace Haptics {
   namespace SerialComm {
 
     Logging::Logger logger("Serial");
 
-    // Main tick() function called from loop().
-    void tick() {
-      if (Serial.available() > 0) {
-        String input = Serial.readStringUntil('\n');
-        input = trim(input);
-        if (input.length() == 0)
-          return;
-      
-        Haptics::globals.commandToProcess = input;
-        Haptics::globals.processSerCommand = true;
-        logger.debug("New input: ", input);
+    // Text commands and binary frames share the port, the framer tells them apart
+    static String line;
+    static bool lineSyncStarted = false;
+    static unsigned long lastInputMs = 0;
+    static uint8_t frameBuffer[Frames::cobsMaxEncoded(FAST_PATH_BUFFER_SIZE)];
+    static Frames::SerialFramer framer(frameBuffer, sizeof(frameBuffer));
+
+    void SerialTransport::poll() {
+      // never waits: only bytes already received are read, a partial line or frame is finished on a later pass
+      int available = Serial.available();
+      const unsigned long now = millis();
+      if (!lineSyncStarted) {
+        // input already waiting on the first pass may be mid-stream, it doesn't count as a pause
+        lineSyncStarted = true;
+        lastInputMs = now;
       }
+      if (available > 0) {
+        if (now - lastInputMs >= SERIAL_SYNC_IDLE_MS)
+          framer.pause();
+        lastInputMs = now;
+      }
+      while (available-- > 0) {
+        const uint8_t c = (uint8_t)Serial.read();
+        switch (framer.push(c)) {
+        case Frames::SerialFramer::SERIAL_LINE_CHAR:
+          line += (char)c;
+          break;
+        case Frames::SerialFramer::SERIAL_LINE_RESET:
+          line = "";
+          break;
+        case Frames::SerialFramer::SERIAL_LINE_READY:
+          // only the line ending, `UPLOAD CHUNK` payloads keep their own whitespace
+          if (line.endsWith("\r"))
+            line.remove(line.length() - 1);
+          Transport::submitCommand(line, {&serialTransport, 0, 0, false});
+          logger.debug("New input: %s", line.c_str());
+          line = "";
+          break;
+        case Frames::SerialFramer::SERIAL_LINE_TOO_LONG:
+          logger.warn("Dropped a command longer than %d characters", SERIAL_LINE_MAX);
+          line = "";
+          break;
+        case Frames::SerialFramer::SERIAL_LINE_UNSYNCED:
+          logger.warn("Dropped serial input that began mid-line");
+          line = "";
+          break;
+        case Frames::SerialFramer::SERIAL_FRAME:
+          // the payload is a raw OSC packet, exactly what the fast path port receives.
+          // an oversized or corrupt frame decodes to nothing and is counted as malformed
+          Transport::dispatchPacket(frameBuffer, framer.frameLength(), {&serialTransport, 0, 0, false});
+          break;
+        default:
+          // a line with nothing but its line ending is skipped
+          if (c == '\n')
+            line = "";
+          break;
+        }
+      }
+    }
+
+    void SerialTransport::reply(const Transport::Origin &origin, const char *chunk, size_t len, uint16_t index, bool last) {
+      Serial.write((const uint8_t *)chunk, len);
+      if (last)
+        Serial.println();
     }
 
   } // namespace SerialComm
@@ -3,10 +3,22 @@
 
 #include <Arduino.h>
 
+#include "transport/transport.h"
+
 namespace Haptics {
   namespace SerialComm {
-    // Call this function every loop iteration to check for new serial input.
-    void tick();
+    // The serial transport: one text command per line, or binary frames delimited by 0x00,
+    // each a COBS encoded raw OSC packet (motor frames and `/command`, like the fast path port).
+    class SerialTransport : public Transport::Interface {
+    public:
+      const char *name() const override { return "serial"; }
+      // Checks for new serial input, polled every loop iteration.
+      void poll() override;
+      // Chunks are written back to back so the reply reads as one line.
+      void reply(const Transport::Origin &origin, const char *chunk, size_t len, uint16_t index, bool last) override;
+    };
+
+    inline SerialTransport serialTransport;
   }
 }
 
@@ -7,6 +7,8 @@
 #define MAX_I2C_MOTORS  64
 #define MAX_LEDC_MOTORS 64
 #define MAX_MOTORS MAX_I2C_MOTORS + MAX_LEDC_MOTORS
+/// one bit per motor, used to track which motors changed since the last update
+#define MOTOR_BITMAP_WORDS (((MAX_MOTORS) + 31) / 32)
 
 // pwm frequency of pca motors
 #define PCA_FREQUENCY 1500 
@@ -24,8 +26,25 @@
 /// Wireless defines
 #define OSC_MOTOR_CHAR_NUM 4
 #define RECIEVE_PORT 1027
+/// raw UDP port for motor frames that bypass ArduinoOSC dispatch
+#define MOTOR_FAST_PORT 1028
+/// largest UDP payload that fits an unfragmented ethernet frame
+#define FAST_PATH_BUFFER_SIZE 1472
+/// ESP32 receive task, above loop() so a waiting packet is decoded straight away
+#define RECEIVE_TASK_STACK 4096
+#define RECEIVE_TASK_PRIORITY 3
+/// receive shares the core the WiFi stack runs on, output gets the other one to itself
+#define RECEIVE_TASK_CORE 0
 #define MULTICAST_PORT 6868
 #define MULTICAST_GROUP 239,0,0,1
+/// legacy JSON broadcast for hosts without DNS-SD, only sent while no host is talking to us
+#define BROADCAST_PERIOD_MS 10000
+/// DNS-SD service, `_haptics._udp`
+#define DISCOVERY_SERVICE "haptics"
+#define DISCOVERY_PROTOCOL "udp"
+/// shared motor stream, one combined frame for every board on the body
+#define MOTOR_STREAM_PORT 6869
+#define MOTOR_STREAM_GROUP 239,0,0,2
 #define AP_NAME "Haptics-Connect-To-Me"
 #define OTA_PASS "Haptics-OTA"
 /// Whether OTA should be disabled 1minute after boot or not.
@@ -34,13 +53,83 @@
 #define OTA_UPDATE_MS 1000
 
 #define HEARTBEAT_ADDRESS "/hrtbt"
+/// hosts that can be connected at once (game, monitoring tools), and how long a silent one is kept
+#define MAX_SESSIONS 4
+#define SESSION_TIMEOUT_MS 60000
+/// 2hz, each heartbeat carries a telemetry blob
+#define HEARTBEAT_PERIOD_MS 500
+/// telemetry blob layout version and length, bump the version whenever the layout changes
+#define TELEMETRY_VERSION 1
+#define TELEMETRY_SIZE 50
 #define PING_ADDRESS "/ping"
 #define COMMAND_ADDRESS "/command"
 #define MOTOR_ADDRESS "/h"
+/// reply to a traced motor frame: int32 token, int32 receive to output us, int32 receive to reply us
+#define LATENCY_ADDRESS "/latency"
+/// packed big-endian uint16 blob, half the size of the hex string frames
+#define MOTOR_BLOB_ADDRESS "/hb"
+/// (uint16 index, uint16 value) pairs, only touched motors are updated
+#define MOTOR_SPARSE_ADDRESS "/hs"
+/// several blob frames with relative playout offsets, queued and released on schedule
+#define MOTOR_BUNDLE_ADDRESS "/hq"
+/// a blob frame prefixed with the uint32 host time (us) to output it at, see `SYNC_ADDRESS`
+#define MOTOR_TIMED_ADDRESS "/ht"
+/// (uint16 group mask, uint8 mode, uint8 reserved, uint16 value) entries that set or scale whole motor groups
+#define MOTOR_GROUP_ADDRESS "/hg"
+/// advertised in the ping response so hosts know which frame types they can send
+#define MOTOR_FRAME_FORMATS "hex16,blob16,sparse16,bundle16,timed16,group16,hex8,blob8,bundle8,timed8"
+/// a sequence number this far behind the last one means the host restarted its counter
+#define SEQUENCE_RESET_WINDOW 1024
+/// frames that can wait in the playout queue, and so the most frames one bundle can carry
+#define MAX_QUEUED_FRAMES 8
+/// internal output rate while interpolating between received frames (500hz)
+#define INTERP_PERIOD_US 2000
+/// host clock sync: exchange period, samples the best round trip is picked from,
+/// shortest span drift is measured over, and how long an estimate stays valid without new samples
+#define SYNC_ADDRESS "/sync"
+#define SYNC_PERIOD_MS 2000
+#define SYNC_SAMPLES 8
+#define SYNC_DRIFT_MIN_US 10000000
+#define SYNC_TIMEOUT_US 30000000
+/// timed frames further ahead than this are assumed to be a bad timestamp and output at once
+#define SYNC_MAX_LEAD_US 1000000
+/// how often the output failsafe checks for a gap in frames
+#define FAILSAFE_PERIOD_US 1000
+/// dual core output task, above loop() so logging and config saves can't hold back the motors
+#define PIPELINE_TASK_STACK 4096
+#define PIPELINE_TASK_PRIORITY 2
+#define PIPELINE_TASK_CORE 1
+/// control events that can wait for the output path, more than a loop() pass can produce
+#define MAX_CONTROL_EVENTS 8
+/// latency histograms cover the last one to two windows of this many frames
+#define LATENCY_WINDOW 1024
+/// how often the output path publishes latency summaries for `GET LATENCY` and the heartbeat
+#define LATENCY_PUBLISH_PERIOD_US 100000
+/// traced frames that can wait for their `/latency` reply
+#define MAX_LATENCY_TRACES 4
 
-// internal (calculated for 64 motors on each)
-#define JSON_SIZE 4096
+/// command responses are sent in chunks of at most this many characters
+#define RESPONSE_CHUNK_SIZE 512
+/// transports polled from loop(), see `Transport::add`
+#define MAX_TRANSPORTS 4
+/// commands that can wait for loop(), like `UPLOAD CHUNK`s sent back to back, more get a busy error
+#define MAX_QUEUED_COMMANDS 4
+/// serial receive buffer, holds a burst of binary frames between loop() passes
+#define SERIAL_RX_BUFFER_SIZE 2048
+/// longer serial text commands are dropped, `UPLOAD` is the way to send more
+#define SERIAL_LINE_MAX 8192
+/// a pause in serial input this long means the next byte starts a new line
+#define SERIAL_SYNC_IDLE_MS 50
+/// most commands one `BATCH` can carry
+#define MAX_BATCH_COMMANDS 32
+/// chunked UPLOAD limits, enough for a full `SET ALL` with a long node map
+#define UPLOAD_MAX_SIZE 8192
+#define UPLOAD_MAX_CHUNKS 64
+
+// internal (calculated for 64 motors on each, plus a group mask per motor)
+#define JSON_SIZE 6144
 #define NODE_LOCATION_DIGITS 4 
+/// motor groups addressable by `MOTOR_GROUP_ADDRESS`, each motor stores its groups as a uint16 mask
 #define MAX_NODE_GROUPS 10
 
 #define CONFIG_VERSION 1
@@ -0,0 +1,113 @@
+#include "telemetry.h"
+#include "globals.h"
+#include "pipeline/pipeline.h"
+#include "wifi/callbacks.h"
+#include "software_defines.h"
+
+#if defined(ESP8266)
+    #include <ESP8266WiFi.h>
+#else
+    #include <WiFi.h>
+#endif
+
+namespace Haptics {
+namespace Telemetry {
+
+    static uint16_t loopRate = 0;
+    static int16_t tempCentiC = TEMP_UNAVAILABLE;
+    static uint8_t thermalState = THERMAL_OK;
+    static uint32_t minFreeHeap = UINT32_MAX;
+
+    void setLoopRate(uint32_t loopsPerSecond)
+    {
+        loopRate = loopsPerSecond > UINT16_MAX ? UINT16_MAX : (uint16_t)loopsPerSecond;
+    }
+
+    void setTemperature(float celsius)
+    {
+        tempCentiC = (int16_t)constrain(celsius * 100.0f, -32768.0f, 32766.0f);
+        if (celsius >= MAX_TEMP)
+            thermalState = THERMAL_HOT;
+        else if (celsius >= MIN_TEMP_COOLDOWN)
+            thermalState = THERMAL_WARM;
+        else
+            thermalState = THERMAL_OK;
+    }
+
+    void collect(Snapshot &out)
+    {
+        out.uptimeMs = millis();
+        out.loopRate = loopRate;
+        out.thermalState = thermalState;
+        out.tempCentiC = tempCentiC;
+        out.rssi = (int8_t)WiFi.RSSI();
+
+        out.freeHeap = ESP.getFreeHeap();
+#if defined(ESP8266)
+        // no allocator low-water mark, track it between heartbeats instead
+        out.cpuMhz = ESP.getCpuFreqMHz();
+        if (out.freeHeap < minFreeHeap)
+            minFreeHeap = out.freeHeap;
+        out.minFreeHeap = minFreeHeap;
+#else
+        out.cpuMhz = getCpuFrequencyMhz();
+        out.minFreeHeap = ESP.getMinFreeHeap();
+#endif
+
+        // a copy from between packets, the counters are never caught half updated
+        const Frames::FrameStats stats = Wireless::frameStats();
+        out.received = stats.received;
+        out.applied = stats.applied;
+        out.dropped = stats.droppedStale + stats.duplicates;
+        out.lost = stats.lost;
+        out.malformed = stats.malformed;
+
+        const Frames::LatencyHistogram::Summary &commit = Pipeline::latency().total;
+        out.commitAvgUs = commit.avgUs;
+        out.commitP99Us = commit.p99Us;
+    }
+
+    static uint8_t *put16(uint8_t *out, uint16_t value)
+    {
+        out[0] = value >> 8;
+        out[1] = value;
+        return out + 2;
+    }
+
+    static uint8_t *put32(uint8_t *out, uint32_t value)
+    {
+        out[0] = value >> 24;
+        out[1] = value >> 16;
+        out[2] = value >> 8;
+        out[3] = value;
+        return out + 4;
+    }
+
+    size_t pack(const Snapshot &snapshot, uint8_t *out, size_t outSize)
+    {
+        if (outSize < TELEMETRY_SIZE)
+            return 0;
+
+        uint8_t *p = out;
+        *p++ = TELEMETRY_VERSION;
+        *p++ = snapshot.thermalState;
+        p = put16(p, snapshot.cpuMhz);
+        p = put32(p, snapshot.uptimeMs);
+        p = put16(p, snapshot.loopRate);
+        *p++ = (uint8_t)snapshot.rssi;
+        *p++ = 0; // reserved
+        p = put16(p, (uint16_t)snapshot.tempCentiC);
+        p = put32(p, snapshot.freeHeap);
+        p = put32(p, snapshot.minFreeHeap);
+        p = put32(p, snapshot.received);
+        p = put32(p, snapshot.applied);
+        p = put32(p, snapshot.dropped);
+        p = put32(p, snapshot.lost);
+        p = put32(p, snapshot.malformed);
+        p = put32(p, snapshot.commitAvgUs);
+        p = put32(p, snapshot.commitP99Us);
+        return p - out;
+    }
+
+} // namespace Telemetry
+} // namespace Haptics
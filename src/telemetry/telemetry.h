@@ -0,0 +1,52 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+
+namespace Haptics {
+namespace Telemetry {
+
+    /// Device health carried in every heartbeat, so hosts can watch a fleet without serial.
+    struct Snapshot {
+        uint32_t uptimeMs;
+        uint16_t loopRate;     // loop() passes in the last second
+        uint16_t cpuMhz;       // drops when the board throttles
+        uint8_t thermalState;  // see `ThermalState`
+        int8_t rssi;           // dBm
+        int16_t tempCentiC;    // 0.01 °C, `TEMP_UNAVAILABLE` on boards without a sensor
+        uint32_t freeHeap;
+        uint32_t minFreeHeap;  // lowest free heap seen since boot
+        uint32_t received;     // motor frame counters for the current host session
+        uint32_t applied;
+        uint32_t dropped;      // stale and duplicate frames
+        uint32_t lost;
+        uint32_t malformed;
+        uint32_t commitAvgUs;  // receive to motors
+        uint32_t commitP99Us;
+    };
+
+    enum ThermalState : uint8_t {
+        THERMAL_OK,
+        THERMAL_WARM, // above the cooldown temperature, limp mode won't recover until back below it
+        THERMAL_HOT,  // at the limp threshold
+    };
+
+    static constexpr int16_t TEMP_UNAVAILABLE = 0x7fff;
+
+    /// @brief Records the loop rate measured over the last second.
+    void setLoopRate(uint32_t loopsPerSecond);
+
+    /// @brief Records the latest chip temperature reading.
+    void setTemperature(float celsius);
+
+    /// @brief Fills `out` with the current telemetry.
+    void collect(Snapshot &out);
+
+    /// @brief Packs `snapshot` into the heartbeat blob, see README for the layout.
+    /// @return bytes written, 0 if `outSize` is smaller than `TELEMETRY_SIZE`
+    size_t pack(const Snapshot &snapshot, uint8_t *out, size_t outSize);
+
+} // namespace Telemetry
+} // namespace Haptics
+
+#endif // TELEMETRY_H
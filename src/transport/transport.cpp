@@ -0,0 +1,162 @@
+#include "transport.h"
+#include "globals.h"
+#include "config/config.h"
+#include "config/config_parser.h"
+#include "config/response_writer.h"
+#include "logging/Logger.h"
+#include "pipeline/pipeline.h"
+#include "wifi/callbacks.h"
+#if !defined(ESP8266)
+#include <mutex>
+#endif
+
+namespace Haptics {
+namespace Transport {
+
+    Logging::Logger logger("Transport");
+
+    static Interface *transports[MAX_TRANSPORTS];
+    static size_t transportCount = 0;
+
+    void add(Interface *transport)
+    {
+        for (size_t i = 0; i < transportCount; i++)
+        {
+            if (transports[i] == transport)
+                return;
+        }
+        if (transportCount == MAX_TRANSPORTS)
+        {
+            logger.error("No room for the %s transport", transport->name());
+            return;
+        }
+        transports[transportCount++] = transport;
+    }
+
+    void pollAll()
+    {
+        for (size_t i = 0; i < transportCount; i++)
+            transports[i]->poll();
+    }
+
+    void dispatchFrame(const Frames::RawMotorMessage &frame, const Origin &origin)
+    {
+        origin.via->received(origin, true);
+        Wireless::applyMotorFrame(frame, origin.shared);
+    }
+
+    void dispatchPacket(uint8_t *packet, size_t len, const Origin &origin)
+    {
+        const char *text;
+        size_t textLen;
+        switch (Wireless::receivePacket(packet, len, origin.shared, text, textLen))
+        {
+        case Frames::Receiver::RECEIVE_OUTPUT:
+        case Frames::Receiver::RECEIVE_DROPPED:
+            origin.via->received(origin, true);
+            break;
+        case Frames::Receiver::RECEIVE_COMMAND:
+            origin.via->received(origin, false);
+            submitCommand(String(text), origin);
+            break;
+        case Frames::Receiver::RECEIVE_INVALID:
+            break;
+        }
+    }
+
+#if !defined(ESP8266)
+    static std::mutex commandMutex;
+#endif
+
+    /// Guards the command queue, the receive task and loop() can both submit to it.
+    struct CommandLock {
+#if !defined(ESP8266)
+        CommandLock() { commandMutex.lock(); }
+        ~CommandLock() { commandMutex.unlock(); }
+#else
+        CommandLock() {}
+#endif
+    };
+
+    struct QueuedCommand {
+        String text;
+        Origin origin;
+    };
+
+    static QueuedCommand queuedCommands[MAX_QUEUED_COMMANDS];
+    static size_t queueHead = 0;
+    static size_t queueLength = 0;
+    // the latest sender turned away by a full queue, told so from loop() like any other reply
+    static Origin busyOrigin;
+    static bool busyPending = false;
+
+    void submitCommand(const String &text, const Origin &origin)
+    {
+        CommandLock lock;
+        if (queueLength == MAX_QUEUED_COMMANDS)
+        {
+            busyOrigin = origin;
+            busyPending = true;
+            return;
+        }
+        QueuedCommand &slot = queuedCommands[(queueHead + queueLength) % MAX_QUEUED_COMMANDS];
+        slot.text = text;
+        slot.origin = origin;
+        queueLength++;
+    }
+
+    /// @brief `ResponseWriter` sink that hands each chunk to the transport the command came from.
+    static void replyToOrigin(const char *chunk, size_t len, uint16_t index, bool last, void *context)
+    {
+        const Origin *origin = (const Origin *)context;
+        origin->via->reply(*origin, chunk, len, index, last);
+    }
+
+    /// @brief Tells a sender its command was dropped because the queue was full.
+    static void replyBusy(const Origin &origin)
+    {
+        Conf::ResponseWriter response(&replyToOrigin, (void *)&origin);
+        response.write("Error: busy, " + String(MAX_QUEUED_COMMANDS) + " commands already waiting, resend it");
+        response.finish();
+    }
+
+    void processCommand()
+    {
+        String command;
+        Origin origin;
+        bool hasCommand = false;
+        Origin busy;
+        bool replyToBusy = false;
+        {
+            CommandLock lock;
+            replyToBusy = busyPending;
+            busy = busyOrigin;
+            busyPending = false;
+            if (queueLength > 0)
+            {
+                QueuedCommand &slot = queuedCommands[queueHead];
+                command = slot.text;
+                origin = slot.origin;
+                slot.text = "";
+                queueHead = (queueHead + 1) % MAX_QUEUED_COMMANDS;
+                queueLength--;
+                hasCommand = true;
+            }
+        }
+
+        if (replyToBusy)
+            replyBusy(busy);
+        if (!hasCommand)
+            return;
+
+        // moves the heavy commands out of the receive path, one per loop() pass
+        Conf::ResponseWriter response(&replyToOrigin, &origin);
+        Conf::Parser::parseInput(command, response);
+
+        // neither the output path nor the receive side read `conf` itself, hand them the (possibly) changed values
+        Pipeline::applyConfig(Conf::conf);
+        Wireless::applyReceiveConfig(Conf::conf);
+    }
+
+} // namespace Transport
+} // namespace Haptics
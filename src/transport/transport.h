@@ -0,0 +1,78 @@
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <Arduino.h>
+
+#include "software_defines.h"
+#include "frames/codec.h"
+
+namespace Haptics {
+namespace Transport {
+
+    /// Motor frames and commands reach the device over several transports (OSC, the raw UDP
+    /// fast path and stream, serial). Each one only moves bytes: it hands whole packets, or
+    /// frames it already split out, to the shared decoder below, so every transport gets
+    /// the same decode path and the same counters.
+
+    class Interface;
+
+    /// Where a packet came from, so its command reply and session bookkeeping go back the same way.
+    struct Origin {
+        Interface *via;
+        /// @brief IPv4 address of the sender, 0 on links without one.
+        uint32_t ip;
+        /// @brief Port of the sender, 0 on links without one.
+        uint16_t port;
+        /// @brief The packet carries the shared multicast stream, each board only keeps its `stream_offset` slice.
+        bool shared;
+    };
+
+    class Interface {
+    public:
+        /// @brief Short name for logs.
+        virtual const char *name() const = 0;
+
+        /// @brief Drains pending input into the decoder. Transports with their own receive task leave this empty.
+        virtual void poll() {}
+
+        /// @brief Sends one chunk of a command reply back to where the command came from.
+        /// Same contract as a `ResponseWriter` sink, always called from loop().
+        virtual void reply(const Origin &origin, const char *chunk, size_t len, uint16_t index, bool last) = 0;
+
+        /// @brief Called for every packet that decoded, e.g. to keep the sender's session alive.
+        /// May be called from a receive task.
+        /// @param motorFrame whether it was a motor frame rather than a command
+        virtual void received(const Origin &origin, bool motorFrame) {}
+    };
+
+    /// @brief Adds a transport to the ones `pollAll` drains.
+    void add(Interface *transport);
+
+    /// @brief Polls every added transport, call every loop() pass.
+    void pollAll();
+
+    /// @brief Decodes a raw OSC motor frame or `COMMAND_ADDRESS` message, without building an `OscMessage`.
+    /// Commands on the shared stream are ignored.
+    /// Safe to call from any task.
+    /// @param packet the packet, shared stream packets are sliced in place
+    /// @param len length of `packet`
+    void dispatchPacket(uint8_t *packet, size_t len, const Origin &origin);
+
+    /// @brief Applies a motor frame a transport already split out of its packet.
+    /// Safe to call from any task.
+    /// @param frame the frame, shared stream payloads are sliced in place
+    void dispatchFrame(const Frames::RawMotorMessage &frame, const Origin &origin);
+
+    /// @brief Queues a command for `processCommand`. When `MAX_QUEUED_COMMANDS` are already waiting
+    /// it's dropped, and the sender gets a busy error from the next `processCommand`.
+    /// Safe to call from any task.
+    void submitCommand(const String &text, const Origin &origin);
+
+    /// @brief Runs the oldest queued command, if any, and streams its reply back through its transport.
+    /// Call from loop(), commands may take a while.
+    void processCommand();
+
+} // namespace Transport
+} // namespace Haptics
+
+#endif // TRANSPORT_H
@@ -1,4 +1,10 @@
 #include "callbacks.h"
+#include "pipeline/pipeline.h"
+#include "sessions.h"
+#include "transport/transport.h"
+#if !defined(ESP8266)
+#include <mutex>
+#endif
 
 namespace Haptics
 {
@@ -38,7 +44,7 @@ namespace Haptics
                 setLedcMotor(index, UINT16_MAX);
 
                 // bumpTime has not elapsed yet
-            } else if (now - *timeBumpStart < Haptics::Conf::conf.bump_time_us) {
+            } else if (now - *timeBumpStart < Pipeline::config().bump_time_us) {
                 setLedcMotor(index, UINT16_MAX);
 
                 // bumpTime is elapsed
@@ -65,7 +71,7 @@ namespace Haptics
                 setI2CMotor(index, UINT16_MAX);
 
                 // bumpTime has not elapsed yet
-            } else if (now - *timeBumpStart < Haptics::Conf::conf.bump_time_us) {
+            } else if (now - *timeBumpStart < Pipeline::config().bump_time_us) {
                 setI2CMotor(index, UINT16_MAX);
 
                 // bumpTime is elapsed
@@ -80,7 +86,8 @@ namespace Haptics
         void handleLEDCIndex(uint16_t i, const int64_t now, uint16_t global_i) {
             int64_t *startBumpTime = &Haptics::globals.bumpActivateTime[global_i];
             uint16_t* val = &Haptics::globals.allMotorVals[global_i];
-            uint16_t* thresh = &Haptics::Conf::conf.bump_start_threshold;
+            uint16_t threshold = Pipeline::config().bump_start_threshold;
+            uint16_t* thresh = &threshold;
             bool *hasBumped = &Haptics::globals.bumpSinceZero[global_i];
 
             if (*val == 0)
@@ -110,7 +117,8 @@ namespace Haptics
         void handleI2CIndex(uint16_t i, const int64_t now, uint16_t global_i) {
             int64_t *startBumpTime = &Haptics::globals.bumpActivateTime[global_i];
             uint16_t* val = &Haptics::globals.allMotorVals[global_i];
-            uint16_t* thresh = &Haptics::Conf::conf.bump_start_threshold;
+            uint16_t threshold = Pipeline::config().bump_start_threshold;
+            uint16_t* thresh = &threshold;
             bool *hasBumped = &Haptics::globals.bumpSinceZero[global_i];
 
             if (*val == 0)
@@ -148,67 +156,180 @@ namespace Haptics
         ///
         void updateMotorVals()
         {
-            lastPacketMs = millis();
-
-            const uint16_t totalMotors = Haptics::Conf::conf.motor_map_i2c_num + Haptics::Conf::conf.motor_map_ledc_num;
-            const int64_t bumpTime = Haptics::Conf::conf.bump_time_us;
-            // Get microsecond timestamp for both platforms
-#if defined(ESP8266)
-            const int64_t now = system_get_time(); // ESP8266 microseconds
-#else
-            const int64_t now = esp_timer_get_time(); // ESP32 microseconds
-#endif
+            // runs on the output path, which has its own copy of the config
+            const Conf::OutputConfig &conf = Pipeline::config();
+            const uint16_t totalMotors = conf.motor_map_i2c_num + conf.motor_map_ledc_num;
+            const int64_t now = nowMicros();
+            bool bumpPending = false;
             for (uint16_t i = 0; i < totalMotors; i++)
             {
+                // untouched motors only need another pass while their bump is running
+                if (!Frames::isDirty(Haptics::globals.dirtyMotors, i) && Haptics::globals.bumpActivateTime[i] == 0)
+                    continue;
+
                 // take ledc values first
-                if (i < Haptics::Conf::conf.motor_map_ledc_num)
+                if (i < conf.motor_map_ledc_num)
                 {
                     handleLEDCIndex(i, now, i);
                 }
                 else
                 { // past ledc, subtract ledc to get I2C index
-                    handleI2CIndex(i - Conf::conf.motor_map_ledc_num, now, i);
+                    handleI2CIndex(i - conf.motor_map_ledc_num, now, i);
                 }
+                bumpPending |= Haptics::globals.bumpActivateTime[i] != 0;
             }
+            memset(Haptics::globals.dirtyMotors, 0, sizeof(Haptics::globals.dirtyMotors));
+
+            // come back next loop to finish any bump that is still running
+            if (bumpPending)
+                Haptics::globals.updatedMotors = true;
         }
 
-        void motorMessage_callback(const OscMessage &message)
+#if !defined(ESP8266)
+        static std::mutex receiveMutex;
+#endif
+
+        /// Serializes the receive side. On ESP32 the receive task and the OSC callbacks in
+        /// loop() both produce frames, the ESP8266 only ever receives from loop().
+        struct ReceiveLock {
+#if !defined(ESP8266)
+            ReceiveLock() { receiveMutex.lock(); }
+            ~ReceiveLock() { receiveMutex.unlock(); }
+#else
+            ReceiveLock() {}
+#endif
+        };
+
+        void resetReceiveSession(uint8_t motorBits)
         {
-            lastPacketMs = millis();
+            ReceiveLock lock;
+            Haptics::motorReceiver.reset(motorBits);
+        }
 
+        void applyReceiveConfig(const Conf::Config &conf)
+        {
+            ReceiveLock lock;
+            Haptics::motorReceiver.configure(conf.motor_map_ledc_num + conf.motor_map_i2c_num, conf.stream_offset, conf.motor_groups);
+        }
+
+        Frames::FrameStats frameStats()
+        {
+            ReceiveLock lock;
+            return Haptics::motorReceiver.stats();
+        }
+
+        void updateClockSync(uint32_t t1, uint32_t t2, uint32_t t3, int64_t arrivalUs)
+        {
+            ReceiveLock lock;
+            Haptics::clockSync.addSample(t1, t2, t3, (uint32_t)arrivalUs, arrivalUs);
+        }
+
+        /// @brief Bookkeeping for a packet the receiver took, wakes the output path if it has something new.
+        static void noteOutcome(Frames::Receiver::Outcome outcome)
+        {
+            if (outcome == Frames::Receiver::RECEIVE_OUTPUT)
+                Pipeline::notify();
+            if (outcome != Frames::Receiver::RECEIVE_OUTPUT && outcome != Frames::Receiver::RECEIVE_DROPPED)
+                return;
+
+            // only frames from a host count as hearing from it, the output path's own fade and ramp steps don't
+            lastPacketMs = millis();
             if (first_packet)
             {
-                logger.debug("FIRST PACKET");
+                // time to first frame, the number boot time changes show up in
+                logger.debug("FIRST PACKET, %lu ms after boot", millis());
                 first_packet = false;
             }
+        }
 
-            // create char array
-            String msg_str = message.arg<String>(0);
-            int msg_length = msg_str.length();
-            char msg_char[msg_length + 1]; // +1 for null terminator
-            msg_str.toCharArray(msg_char, msg_length + 1);
+        Frames::Receiver::Outcome receivePacket(uint8_t *packet, size_t len, bool shared, const char *&command, size_t &commandLen)
+        {
+            // timestamp before waiting on another receive path
+            const int64_t receivedUs = nowMicros();
+            ReceiveLock lock;
+            const Frames::Receiver::Outcome outcome = Haptics::motorReceiver.receivePacket(packet, len, shared, receivedUs, command, commandLen);
+            noteOutcome(outcome);
+            return outcome;
+        }
 
-            const uint8_t numElements = msg_length / OSC_MOTOR_CHAR_NUM;
+        void applyMotorFrame(const Frames::RawMotorMessage &frame, bool shared)
+        {
+            // timestamp before waiting on another receive path
+            const int64_t receivedUs = nowMicros();
+            ReceiveLock lock;
+            noteOutcome(Haptics::motorReceiver.receive(frame, shared, receivedUs));
+        }
 
-            // process each hex number
-            char snippet[OSC_MOTOR_CHAR_NUM + 1]; // +1 for null terminator
-            for (uint16_t i = 0; i < numElements; i++)
-            {
-                memcpy(snippet, &msg_char[OSC_MOTOR_CHAR_NUM * i], OSC_MOTOR_CHAR_NUM);
-                snippet[OSC_MOTOR_CHAR_NUM] = '\0'; // null terminate the snippet
-                // convert a section of the input string into an integer number
-                Haptics::globals.allMotorVals[i] = strtol(snippet, NULL, 16);
-            }
+        /// @brief Where an OSC message came from, as the shared decoder sees it.
+        static Transport::Origin oscOrigin(const OscMessage &message)
+        {
+            IPAddress sender;
+            sender.fromString(message.remoteIP());
+            return {&oscTransport, (uint32_t)sender, (uint16_t)message.remotePort(), false};
+        }
 
-            // push the changes to the individual motor array's outside of ISR time
-            Haptics::globals.updatedMotors = true;
+        /// @brief Pulls the payload, optional int32 sequence number and optional int32 trace token out of an OSC motor frame.
+        static void applyOscFrame(Frames::FrameKind kind, const OscMessage &message, const uint8_t *payload, size_t len)
+        {
+            Frames::RawMotorMessage frame;
+            frame.kind = kind;
+            frame.payload = payload;
+            frame.payloadLen = len;
+            frame.hasSequence = message.size() > 1;
+            frame.sequence = frame.hasSequence ? (uint32_t)message.arg<int32_t>(1) : 0;
+            frame.hasToken = message.size() > 2;
+            frame.token = frame.hasToken ? (uint32_t)message.arg<int32_t>(2) : 0;
+            Transport::dispatchFrame(frame, oscOrigin(message));
+        }
+
+        void motorMessage_callback(const OscMessage &message)
+        {
+            const String msg_str = message.arg<String>(0);
+            applyOscFrame(Frames::FRAME_HEX16, message, (const uint8_t *)msg_str.c_str(), msg_str.length());
+        }
+
+        /// @brief Handles `MOTOR_BLOB_ADDRESS` frames, an OSC blob of packed big-endian uint16 values.
+        void motorBlobMessage_callback(const OscMessage &message)
+        {
+            const std::vector<char> blob = message.arg<std::vector<char>>(0);
+            applyOscFrame(Frames::FRAME_BLOB16, message, (const uint8_t *)blob.data(), blob.size());
+        }
+
+        /// @brief Handles `MOTOR_SPARSE_ADDRESS` frames, an OSC blob of (uint16 index, uint16 value) pairs.
+        void motorSparseMessage_callback(const OscMessage &message)
+        {
+            const std::vector<char> blob = message.arg<std::vector<char>>(0);
+            applyOscFrame(Frames::FRAME_SPARSE16, message, (const uint8_t *)blob.data(), blob.size());
+        }
+
+        /// @brief Handles `MOTOR_BUNDLE_ADDRESS` frames, see `Frames::parseBundle` for the layout.
+        void motorBundleMessage_callback(const OscMessage &message)
+        {
+            const std::vector<char> blob = message.arg<std::vector<char>>(0);
+            applyOscFrame(Frames::FRAME_BUNDLE16, message, (const uint8_t *)blob.data(), blob.size());
+        }
+
+        /// @brief Handles `MOTOR_TIMED_ADDRESS` frames, see `Frames::parseTimed` for the layout.
+        void motorTimedMessage_callback(const OscMessage &message)
+        {
+            const std::vector<char> blob = message.arg<std::vector<char>>(0);
+            applyOscFrame(Frames::FRAME_TIMED16, message, (const uint8_t *)blob.data(), blob.size());
+        }
+
+        /// @brief Handles `MOTOR_GROUP_ADDRESS` frames, see `Frames::decodeGroup` for the layout.
+        void motorGroupMessage_callback(const OscMessage &message)
+        {
+            const std::vector<char> blob = message.arg<std::vector<char>>(0);
+            applyOscFrame(Frames::FRAME_GROUP16, message, (const uint8_t *)blob.data(), blob.size());
         }
 
         void commandMessageCallback(const OscMessage &msg)
         {
+            const Transport::Origin origin = oscOrigin(msg);
+            oscTransport.received(origin, false);
+
             // schedule processing the command on the next cycle.
-            Haptics::globals.commandToProcess = msg.arg<String>(0);
-            Haptics::globals.processOscCommand = true;
+            Transport::submitCommand(msg.arg<String>(0), origin);
         }
 
         void printOSCMessage(const OscMessage &message)
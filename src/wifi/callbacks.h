@@ -3,9 +3,11 @@
 
 #include <ArduinoOSCWiFi.h>
 #include "globals.h"
+#include "config/config.h"
 #include "osc.h"
 #include "software_defines.h"
 #include "logging/Logger.h"
+#include "frames/codec.h"
 
 namespace Haptics  {
 namespace Wireless {
@@ -13,7 +15,36 @@ namespace Wireless {
     inline bool first_packet = true;
     void printRaw();
     void updateMotorVals();
+    /// @brief Starts a new host session: forgets sequence numbers, counters and received values.
+    /// @param motorBits bits per motor the session negotiated, 8 or 16
+    void resetReceiveSession(uint8_t motorBits);
+    /// @brief Hands the receive side a copy of the config fields it reads, call whenever `conf` may have changed.
+    void applyReceiveConfig(const Conf::Config &conf);
+    /// @brief A copy of the current session's frame counters, taken while no packet is being received.
+    /// Safe to call from any task.
+    Frames::FrameStats frameStats();
+    /// @brief Adds a completed `SYNC_ADDRESS` exchange to the host clock estimate.
+    /// Safe to call from any task.
+    /// @param t1 our send time, echoed back by the host
+    /// @param t2 host receive time
+    /// @param t3 host send time
+    /// @param arrivalUs local time the reply arrived
+    void updateClockSync(uint32_t t1, uint32_t t2, uint32_t t3, int64_t arrivalUs);
+    /// @brief Runs a raw packet from any receive path through `motorReceiver`, see `Frames::Receiver::receivePacket`.
+    /// Safe to call from any task.
+    Frames::Receiver::Outcome receivePacket(uint8_t *packet, size_t len, bool shared, const char *&command, size_t &commandLen);
+    /// @brief Decodes a motor frame a transport already split out of its packet and publishes it to the output path.
+    /// Safe to call from any task.
+    /// @param frame the frame, a `hasToken` frame gets a `/latency` reply once it reaches the motors
+    /// @param shared whether the frame carries the shared stream, its payload is then sliced
+    /// in place down to this board's `stream_offset` motors
+    void applyMotorFrame(const Frames::RawMotorMessage &frame, bool shared);
     void motorMessage_callback(const OscMessage& message);
+    void motorBlobMessage_callback(const OscMessage& message);
+    void motorSparseMessage_callback(const OscMessage& message);
+    void motorBundleMessage_callback(const OscMessage& message);
+    void motorTimedMessage_callback(const OscMessage& message);
+    void motorGroupMessage_callback(const OscMessage& message);
     void printOSCMessage(const OscMessage& message);
     void commandMessageCallback(const OscMessage& msg);
 
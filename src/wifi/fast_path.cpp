@@ -0,0 +1,230 @@
+#if defined(ESP8266)
+    #include <ESP8266WiFi.h>
+    #include <WiFiUdp.h>
+#else
+    #include <WiFi.h>
+    #include <lwip/sockets.h>
+#endif
+
+#include "fast_path.h"
+#include "sessions.h"
+#include "osc.h"
+#include "software_defines.h"
+#include "config/config.h"
+
+namespace Haptics {
+namespace Wireless {
+
+    static uint8_t packetBuffer[FAST_PATH_BUFFER_SIZE];
+    static bool fastPathStarted = false;
+    static bool streamStarted = false;
+
+    /// @brief Hands one packet to the shared decoder.
+    /// @param shared whether it came from the shared stream, which is sliced down to our motors
+    static void dispatch(size_t len, uint32_t sender, uint16_t port, bool shared)
+    {
+        Transport::dispatchPacket(packetBuffer, len, {&udpTransport, sender, port, shared});
+    }
+
+#if defined(ESP8266)
+    // No spare core or scheduler to block on, the sockets are polled from loop().
+
+    static WiFiUDP fastUdp;
+    static WiFiUDP streamUdp;
+
+    static void startReceiving() {}
+
+    void startFastPath()
+    {
+        if (fastPathStarted)
+            return;
+
+        fastPathStarted = fastUdp.begin(MOTOR_FAST_PORT);
+        if (!fastPathStarted)
+        {
+            logger.warn("Motor fast path failed to open port %d", MOTOR_FAST_PORT);
+            return;
+        }
+        logger.debug("Motor fast path on port: %d", MOTOR_FAST_PORT);
+    }
+
+    void startStream(Haptics::Conf::Config *conf)
+    {
+        if (streamStarted || !conf->stream_enabled)
+            return;
+
+        // ESP8266 beginMulticast requires interface address
+        streamStarted = streamUdp.beginMulticast(WiFi.localIP(), IPAddress(MOTOR_STREAM_GROUP), MOTOR_STREAM_PORT);
+        if (!streamStarted)
+        {
+            logger.warn("Failed to join the motor stream group");
+            return;
+        }
+        logger.debug("Joined motor stream, motors %d-%d", conf->stream_offset,
+                     conf->stream_offset + conf->motor_map_ledc_num + conf->motor_map_i2c_num - 1);
+    }
+
+    static void pollFastPath()
+    {
+        if (!fastPathStarted)
+            return;
+
+        while (fastUdp.parsePacket() > 0)
+        {
+            const int len = fastUdp.read(packetBuffer, sizeof(packetBuffer));
+            if (len > 0)
+                dispatch((size_t)len, (uint32_t)fastUdp.remoteIP(), fastUdp.remotePort(), false);
+        }
+    }
+
+    static void pollStream()
+    {
+        if (!streamStarted)
+            return;
+
+        while (streamUdp.parsePacket() > 0)
+        {
+            const int len = streamUdp.read(packetBuffer, sizeof(packetBuffer));
+            if (len > 0)
+                dispatch((size_t)len, (uint32_t)streamUdp.remoteIP(), streamUdp.remotePort(), true);
+        }
+    }
+
+#else
+    // A task blocks on both sockets and decodes each packet the moment it lands,
+    // instead of waiting for the next loop() pass.
+
+    static int fastSocket = -1;
+    static int streamSocket = -1;
+    static TaskHandle_t receiveTaskHandle = nullptr;
+
+    /// @brief Opens a UDP socket bound to `port` on every interface, -1 on failure.
+    static int openSocket(uint16_t port)
+    {
+        const int sock = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+        if (sock < 0)
+            return -1;
+
+        struct sockaddr_in addr = {};
+        addr.sin_family = AF_INET;
+        addr.sin_port = htons(port);
+        addr.sin_addr.s_addr = htonl(INADDR_ANY);
+        if (bind(sock, (struct sockaddr *)&addr, sizeof(addr)) < 0)
+        {
+            close(sock);
+            return -1;
+        }
+        return sock;
+    }
+
+    static void receiveTask(void *)
+    {
+        for (;;)
+        {
+            fd_set readable;
+            FD_ZERO(&readable);
+            FD_SET(fastSocket, &readable);
+            if (streamSocket >= 0)
+                FD_SET(streamSocket, &readable);
+
+            // sleeps until a packet arrives on either socket
+            const int maxSocket = fastSocket > streamSocket ? fastSocket : streamSocket;
+            if (select(maxSocket + 1, &readable, nullptr, nullptr, nullptr) <= 0)
+                continue;
+
+            struct sockaddr_in sender = {};
+            socklen_t senderLen = sizeof(sender);
+            if (FD_ISSET(fastSocket, &readable))
+            {
+                const int len = recvfrom(fastSocket, packetBuffer, sizeof(packetBuffer), 0, (struct sockaddr *)&sender, &senderLen);
+                if (len > 0)
+                    dispatch((size_t)len, sender.sin_addr.s_addr, ntohs(sender.sin_port), false);
+            }
+            if (streamSocket >= 0 && FD_ISSET(streamSocket, &readable))
+            {
+                senderLen = sizeof(sender);
+                const int len = recvfrom(streamSocket, packetBuffer, sizeof(packetBuffer), 0, (struct sockaddr *)&sender, &senderLen);
+                if (len > 0)
+                    dispatch((size_t)len, sender.sin_addr.s_addr, ntohs(sender.sin_port), true);
+            }
+        }
+    }
+
+    /// @brief Starts the receive task once the fast path socket is open.
+    static void startReceiving()
+    {
+        if (receiveTaskHandle || fastSocket < 0)
+            return;
+
+        xTaskCreatePinnedToCore(receiveTask, "motor_rx", RECEIVE_TASK_STACK, nullptr,
+                                RECEIVE_TASK_PRIORITY, &receiveTaskHandle, RECEIVE_TASK_CORE);
+    }
+
+    void startFastPath()
+    {
+        if (fastPathStarted)
+            return;
+
+        fastSocket = openSocket(MOTOR_FAST_PORT);
+        fastPathStarted = fastSocket >= 0;
+        if (!fastPathStarted)
+        {
+            logger.warn("Motor fast path failed to open port %d", MOTOR_FAST_PORT);
+            return;
+        }
+        logger.debug("Motor fast path on port: %d", MOTOR_FAST_PORT);
+    }
+
+    void startStream(Haptics::Conf::Config *conf)
+    {
+        if (streamStarted || !conf->stream_enabled)
+            return;
+
+        const int sock = openSocket(MOTOR_STREAM_PORT);
+        struct ip_mreq group = {};
+        group.imr_multiaddr.s_addr = (uint32_t)IPAddress(MOTOR_STREAM_GROUP);
+        group.imr_interface.s_addr = htonl(INADDR_ANY);
+        if (sock < 0 || setsockopt(sock, IPPROTO_IP, IP_ADD_MEMBERSHIP, &group, sizeof(group)) < 0)
+        {
+            if (sock >= 0)
+                close(sock);
+            logger.warn("Failed to join the motor stream group");
+            return;
+        }
+        streamSocket = sock;
+        streamStarted = true;
+        logger.debug("Joined motor stream, motors %d-%d", conf->stream_offset,
+                     conf->stream_offset + conf->motor_map_ledc_num + conf->motor_map_i2c_num - 1);
+    }
+
+    // the receive task drains both sockets, nothing to poll
+    static void pollFastPath() {}
+    static void pollStream() {}
+#endif
+
+    void UdpTransport::poll()
+    {
+        pollFastPath();
+        pollStream();
+    }
+
+    void UdpTransport::reply(const Transport::Origin &origin, const char *chunk, size_t len, uint16_t index, bool last)
+    {
+        sendCommandReply(origin, chunk, len, index, last);
+    }
+
+    void UdpTransport::received(const Transport::Origin &origin, bool motorFrame)
+    {
+        noteActivity(origin.ip, motorFrame);
+    }
+
+    void startReceivePaths(Haptics::Conf::Config *conf)
+    {
+        startFastPath();
+        startStream(conf);
+        startReceiving();
+        Transport::add(&udpTransport);
+    }
+
+} // namespace Wireless
+} // namespace Haptics
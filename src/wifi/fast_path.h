@@ -0,0 +1,48 @@
+#ifndef FAST_PATH_H
+#define FAST_PATH_H
+
+#include <Arduino.h>
+
+#include "config/config.h"
+#include "transport/transport.h"
+
+namespace Haptics {
+namespace Wireless {
+
+    /// Motor frames sent to `MOTOR_FAST_PORT` skip ArduinoOSC entirely: the packet is
+    /// parsed in place and handed straight to the shared decoder. `/command` works here
+    /// too, `/ping` stays on the regular OSC port.
+
+    /// On ESP32 a receive task blocks on the fast path and stream sockets and decodes
+    /// every packet as soon as it arrives. The ESP8266 polls them from loop() instead.
+    /// The OSC port belongs to ArduinoOSC and is still polled by `Tick()` every 7ms on both,
+    /// hosts that want the lower latency send their frames here.
+
+    /// The raw UDP transport: the fast path and shared stream sockets.
+    class UdpTransport : public Transport::Interface {
+    public:
+        const char *name() const override { return "udp"; }
+        /// @brief Drains every pending fast path and stream packet. No-op on ESP32.
+        void poll() override;
+        void reply(const Transport::Origin &origin, const char *chunk, size_t len, uint16_t index, bool last) override;
+        void received(const Transport::Origin &origin, bool motorFrame) override;
+    };
+
+    inline UdpTransport udpTransport;
+
+    /// @brief Opens the fast path and, if enabled, the shared stream, then starts receiving.
+    void startReceivePaths(Haptics::Conf::Config *conf);
+
+    /// @brief Opens the motor fast path socket.
+    void startFastPath();
+
+    /// Boards on the same body can share one multicast stream carrying a combined frame.
+    /// Each board applies only motors `[stream_offset, stream_offset + motor count)`.
+
+    /// @brief Joins the shared motor stream group if `stream_enabled` is set.
+    void startStream(Haptics::Conf::Config *conf);
+
+} // namespace Wireless
+} // namespace Haptics
+
+#endif // FAST_PATH_H
@@ -1,6 +1,9 @@
 #include "wifi/callbacks.h"
 #include "logging/Logger.h"
 #include "wifi/osc.h"
+#include "wifi/fast_path.h"
+#include "telemetry/telemetry.h"
+#include "wifi/sessions.h"
 
 namespace Haptics
 {
@@ -73,6 +76,8 @@ namespace Haptics
             // Start listening for OSC server
             OscWiFi.subscribe(RECIEVE_PORT, PING_ADDRESS, &handlePing);
             logger.debug("Server started on port: %d", RECIEVE_PORT);
+            Transport::add(&oscTransport);
+            startReceivePaths(conf);
 
             String mac = WiFi.macAddress();
             String ip = WiFi.localIP().toString();
@@ -91,9 +96,30 @@ namespace Haptics
 #else
             udpClient.beginMulticast(IPAddress(MULTICAST_GROUP), MULTICAST_PORT);
 #endif
+
+            StartDiscovery(conf);
             Broadcast(); // broadcast first time
         }
 
+        /// @brief Advertises `_haptics._udp` so hosts can find us with a DNS-SD query.
+        void StartDiscovery(Haptics::Conf::Config *conf)
+        {
+            if (!MDNS.begin(conf->mdns_name))
+            {
+                logger.warn("mDNS failed to start, only the legacy broadcast is available");
+                return;
+            }
+
+            MDNS.addService(DISCOVERY_SERVICE, DISCOVERY_PROTOCOL, RECIEVE_PORT);
+            MDNS.addServiceTxt(DISCOVERY_SERVICE, DISCOVERY_PROTOCOL, "mac", WiFi.macAddress().c_str());
+            MDNS.addServiceTxt(DISCOVERY_SERVICE, DISCOVERY_PROTOCOL, "name", conf->mdns_name);
+            MDNS.addServiceTxt(DISCOVERY_SERVICE, DISCOVERY_PROTOCOL, "port", String(RECIEVE_PORT).c_str());
+            MDNS.addServiceTxt(DISCOVERY_SERVICE, DISCOVERY_PROTOCOL, "fast_port", String(MOTOR_FAST_PORT).c_str());
+            MDNS.addServiceTxt(DISCOVERY_SERVICE, DISCOVERY_PROTOCOL, "motors", String(conf->motor_map_ledc_num + conf->motor_map_i2c_num).c_str());
+            MDNS.addServiceTxt(DISCOVERY_SERVICE, DISCOVERY_PROTOCOL, "formats", MOTOR_FRAME_FORMATS);
+            logger.debug("Advertising _%s._%s as %s.local", DISCOVERY_SERVICE, DISCOVERY_PROTOCOL, conf->mdns_name);
+        }
+
         void Broadcast()
         {
             // Send broadcast
@@ -108,51 +134,200 @@ namespace Haptics
             return WiFi.status() == WL_CONNECTED;
         }
 
-        void StartHeartBeat(String hostIP, uint16_t sendPort)
+        static unsigned long lastHeartbeatMs = 0;
+
+        /// @brief Sends the telemetry heartbeat to every live session if it is due.
+        static void sendHeartbeat()
         {
-            // Publish heart beat on one second intervals
-            OscWiFi.publish(hostIP, sendPort, HEARTBEAT_ADDRESS)
-                ->setFrameRate(2.);
-            heartbeatPublisher = OscWiFi.getPublishElementRef(hostIP, sendPort, HEARTBEAT_ADDRESS);
+            const unsigned long now = millis();
+            if (now - lastHeartbeatMs < HEARTBEAT_PERIOD_MS)
+                return;
+            lastHeartbeatMs = now;
 
-            if (!heartbeatPublisher)
+            OscMessage heartbeat(HEARTBEAT_ADDRESS);
+            bool packed = false;
+            for (const Session &session : sessions)
             {
-                logger.warn("Heartbeat wasn't established");
+                if (!session.active)
+                    continue;
+                if (!packed)
+                {
+                    // only collected when someone is listening
+                    Telemetry::Snapshot snapshot;
+                    Telemetry::collect(snapshot);
+                    std::vector<char> blob(TELEMETRY_SIZE);
+                    Telemetry::pack(snapshot, (uint8_t *)blob.data(), blob.size());
+                    heartbeat.pushBlob(blob);
+                    packed = true;
+                }
+                oscClient.send(IPAddress(session.ip).toString(), session.port, heartbeat);
             }
         }
 
-        void handlePing(const OscMessage &message)
+        static unsigned long lastSyncMs = 0;
+        static bool syncPending = false;
+        static uint32_t syncSentUs = 0;
+
+        /// @brief Starts a clock sync exchange with the motor host if one is due.
+        static void sendSync()
         {
-            // if we recieve a ping and we were already setup, it is likely a server restart.
-            // In that case the port, ip, and other values should be reinited
+            const unsigned long now = millis();
+            if (now - lastSyncMs < SYNC_PERIOD_MS)
+                return;
+
+            // the clock that matters is the one stamping the frames
+            const Session *host = motorSession();
+            if (!host)
+            {
+                for (const Session &session : sessions)
+                {
+                    if (session.active)
+                    {
+                        host = &session;
+                        break;
+                    }
+                }
+            }
+            if (!host)
+                return;
+            lastSyncMs = now;
+
+            // a reply that never came is simply superseded
+            syncSentUs = (uint32_t)nowMicros();
+            syncPending = true;
+            OscMessage request(SYNC_ADDRESS);
+            request.pushInt32((int32_t)syncSentUs);
+            oscClient.send(IPAddress(host->ip).toString(), host->port, request);
+        }
+
+        /// @brief Completes a clock sync exchange: the host answers with our t1, its receive time t2 and its send time t3.
+        void handleSync(const OscMessage &message)
+        {
+            // stamped first, everything after would count as network delay
+            const int64_t arrivalUs = nowMicros();
+            if (message.size() < 3)
+                return;
 
-            sendPort = message.arg<uint16_t>(0); // Get the host's port from the message
-            hostIP = message.remoteIP();         // Get the host's IP address
+            // only the reply to the latest request, a stale or repeated one would skew the round trip
+            const uint32_t t1 = (uint32_t)message.arg<int32_t>(0);
+            if (!syncPending || t1 != syncSentUs)
+                return;
+            syncPending = false;
+            updateClockSync(t1, (uint32_t)message.arg<int32_t>(1), (uint32_t)message.arg<int32_t>(2), arrivalUs);
+        }
+
+        /// @brief Registers the OSC handlers, only once however many pings arrive.
+        static void subscribeHandlers()
+        {
+            static bool subscribed = false;
+            if (subscribed)
+                return;
+            subscribed = true;
 
             // create our own recieving server
             OscWiFi.subscribe(RECIEVE_PORT, MOTOR_ADDRESS, &motorMessage_callback);
+            OscWiFi.subscribe(RECIEVE_PORT, MOTOR_BLOB_ADDRESS, &motorBlobMessage_callback);
+            OscWiFi.subscribe(RECIEVE_PORT, MOTOR_SPARSE_ADDRESS, &motorSparseMessage_callback);
+            OscWiFi.subscribe(RECIEVE_PORT, MOTOR_BUNDLE_ADDRESS, &motorBundleMessage_callback);
+            OscWiFi.subscribe(RECIEVE_PORT, MOTOR_TIMED_ADDRESS, &motorTimedMessage_callback);
+            OscWiFi.subscribe(RECIEVE_PORT, MOTOR_GROUP_ADDRESS, &motorGroupMessage_callback);
+            OscWiFi.subscribe(RECIEVE_PORT, SYNC_ADDRESS, &handleSync);
             OscWiFi.subscribe(RECIEVE_PORT, COMMAND_ADDRESS, &commandMessageCallback);
 
-            logger.debug("Received ping from: %s", hostIP);
-
             // sending client
             oscClient = OscWiFi.getClient();
+        }
+
+        void handlePing(const OscMessage &message)
+        {
+            // if we recieve a ping and we were already setup, it is likely a server restart.
+            // In that case it just refreshes its session
+            const uint16_t port = message.arg<uint16_t>(0); // Get the host's port from the message
+            IPAddress ip;
+            ip.fromString(message.remoteIP()); // Get the host's IP address
+            const uint16_t sourcePort = (uint16_t)message.remotePort();
+            const unsigned long now = millis();
+
+            // the host may have restarted its frame counter, so a ping starts a new receive session,
+            // unless a host on another address is driving the motors (a monitor tool pinging mustn't disturb the game).
+            // A restarted host pings from a new port, its old session is replaced rather than counted as another host.
+            // hosts that understand 8-bit frames ask for them with a second argument, everyone else stays on 16-bit
+            if (!otherHostStreaming(ip, now))
+                resetReceiveSession((message.size() > 1 && message.arg<int32_t>(1) == 8) ? 8 : 16);
+
+            openSession(ip, sourcePort, port, now);
+            subscribeHandlers();
+            logger.debug("Received ping from: %s", message.remoteIP().c_str());
 
             // Respond to ping
             OscMessage pingResponse(PING_ADDRESS);
             pingResponse.pushInt32(RECIEVE_PORT);
             pingResponse.pushString(WiFi.macAddress());
-            oscClient.send(hostIP, sendPort, pingResponse);
-            logger.debug("Sending hrtbt to %s:%d", hostIP, sendPort);
+            pingResponse.pushString(MOTOR_FRAME_FORMATS); // lets hosts opt into the blob frames
+            pingResponse.pushInt32(MOTOR_FAST_PORT);
+            // LEDC only devices can't use the low byte, so they would rather get 8-bit frames
+            pingResponse.pushInt32(Conf::conf.motor_map_i2c_num == 0 ? 8 : 16);
+            oscClient.send(message.remoteIP(), port, pingResponse);
 
-            StartHeartBeat(hostIP, sendPort);
             globals.beenPinged = true;
         }
 
+        void sendCommandReply(const Transport::Origin &origin, const char *chunk, size_t len, uint16_t index, bool last)
+        {
+            OscMessage reply(COMMAND_ADDRESS);
+            reply.pushString(chunk);
+            // replies that didn't fit one chunk carry their position so the host can join them
+            if (index != 0 || !last)
+            {
+                reply.pushInt32(index);
+                reply.pushInt32(last ? 1 : 0);
+            }
+            // answered to whoever sent the command
+            const Session *session = findSession(origin.ip);
+            oscClient.send(IPAddress(origin.ip).toString(), session ? session->port : origin.port, reply);
+        }
+
+        void OscTransport::reply(const Transport::Origin &origin, const char *chunk, size_t len, uint16_t index, bool last)
+        {
+            sendCommandReply(origin, chunk, len, index, last);
+        }
+
+        void OscTransport::received(const Transport::Origin &origin, bool motorFrame)
+        {
+            noteActivity(origin.ip, motorFrame);
+        }
+
+        /// @brief Answers traced motor frames that reached the motors since the last tick.
+        static void sendLatencyTraces()
+        {
+            // traced frames come from the host driving the motors
+            const Session *host = motorSession();
+            while (const Frames::LatencyTrace *trace = latencyTraces.peek())
+            {
+                if (host)
+                {
+                    // the host subtracts the time we held the frame from its round trip
+                    OscMessage reply(LATENCY_ADDRESS);
+                    reply.pushInt32((int32_t)trace->token);
+                    reply.pushInt32((int32_t)trace->commitUs);
+                    reply.pushInt32((int32_t)(nowMicros() - trace->receivedUs));
+                    oscClient.send(IPAddress(host->ip).toString(), host->port, reply);
+                }
+                latencyTraces.pop();
+            }
+        }
+
         /// @brief Push and pull OSC updates
         void Tick()
         {
             OscWiFi.update(); // should be called to subscribe + publish osc
+#if defined(ESP8266)
+            MDNS.update(); // ESP32 answers queries from its own task
+#endif
+            sendLatencyTraces();
+            sendHeartbeat();
+            sendSync();
+            expireSessions(millis());
         }
 
         /// @brief logs the usual wifi metrics to teh console.
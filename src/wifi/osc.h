@@ -16,6 +16,7 @@
 #include "config/config.h"
 #include "logging/Logger.h"
 #include "wifi/callbacks.h"
+#include "transport/transport.h"
 
 #ifndef OSC_H
 #define OSC_H
@@ -26,26 +27,36 @@ namespace Wireless {
 // OSC client to send messages back to the hosts
 inline OscWiFiClient oscClient;
 inline WiFiUDP udpClient;
-inline String hostIP;
-inline uint16_t sendPort;
 inline String broadcastMessage;
 
-//publisher references
-inline OscPublishElementRef heartbeatPublisher;
-
 // we need to get host ip first
 inline String selfMac = WiFi.macAddress();
 inline uint32_t recvPort = RECIEVE_PORT;
 
 inline Logging::Logger logger("WIFI");
 
-void StartHeartBeat( String hostIP, uint16_t sendPort);
 void handlePing(const OscMessage& message);
+void handleSync(const OscMessage& message);
 
+void StartDiscovery(Haptics::Conf::Config *conf);
 void Broadcast();
 void Start(Haptics::Conf::Config *conf);
 bool WiFiConnected();
 void Tick();
+/// The UDP-OSC transport: messages ArduinoOSC already dispatched to our callbacks.
+/// ArduinoOSC itself is pumped by `Tick`.
+class OscTransport : public Transport::Interface {
+public:
+    const char *name() const override { return "osc"; }
+    void reply(const Transport::Origin &origin, const char *chunk, size_t len, uint16_t index, bool last) override;
+    void received(const Transport::Origin &origin, bool motorFrame) override;
+};
+
+inline OscTransport oscTransport;
+
+/// @brief Sends one command reply chunk to a host as a `/command` message, for both UDP transports.
+/// Replies go to the port the host pinged with, or straight back to the sender if it never pinged.
+void sendCommandReply(const Transport::Origin &origin, const char *chunk, size_t len, uint16_t index, bool last);
 void printRawPacket();
 void printMetrics();
 
@@ -0,0 +1,79 @@
+#include "sessions.h"
+#include "osc.h"
+#if !defined(ESP8266)
+#include <mutex>
+#endif
+
+namespace Haptics {
+namespace Wireless {
+
+#if !defined(ESP8266)
+    static std::mutex sessionMutex;
+#endif
+
+    /// Guards the session table, the receive task notes activity while loop() opens and expires sessions.
+    struct SessionLock {
+#if !defined(ESP8266)
+        SessionLock() { sessionMutex.lock(); }
+        ~SessionLock() { sessionMutex.unlock(); }
+#else
+        SessionLock() {}
+#endif
+    };
+
+    Session *openSession(const IPAddress &ip, uint16_t sourcePort, uint16_t port, unsigned long now)
+    {
+        Session previous;
+        Session *session;
+        {
+            SessionLock lock;
+            session = sessions.open((uint32_t)ip, sourcePort, port, now, previous);
+        }
+
+        if (previous.active && previous.ip != (uint32_t)ip)
+            logger.debug("Session table full, dropping %s:%d", IPAddress(previous.ip).toString().c_str(), previous.sourcePort);
+        if (!previous.active || previous.ip != (uint32_t)ip)
+            logger.debug("New session %s:%d", ip.toString().c_str(), sourcePort);
+        else if (previous.sourcePort != sourcePort)
+            logger.debug("Session %s moved from port %d to %d", ip.toString().c_str(), previous.sourcePort, sourcePort);
+        return session;
+    }
+
+    Session *findSession(uint32_t ip)
+    {
+        SessionLock lock;
+        return sessions.find(ip);
+    }
+
+    void noteActivity(uint32_t ip, bool motorFrame)
+    {
+        const unsigned long now = millis();
+        SessionLock lock;
+        sessions.noteActivity(ip, motorFrame, now);
+    }
+
+    bool otherHostStreaming(const IPAddress &ip, unsigned long now)
+    {
+        SessionLock lock;
+        return sessions.otherHostStreaming((uint32_t)ip, now);
+    }
+
+    const Session *motorSession()
+    {
+        SessionLock lock;
+        return sessions.motorSession();
+    }
+
+    void expireSessions(unsigned long now)
+    {
+        SessionLock lock;
+        for (const Session &session : sessions)
+        {
+            if (sessions.expired(session, now))
+                logger.debug("Session %s:%d expired", IPAddress(session.ip).toString().c_str(), session.sourcePort);
+        }
+        sessions.expire(now);
+    }
+
+} // namespace Wireless
+} // namespace Haptics
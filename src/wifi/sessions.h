@@ -0,0 +1,45 @@
+#ifndef SESSIONS_H
+#define SESSIONS_H
+
+#include <Arduino.h>
+#include <IPAddress.h>
+
+#include "software_defines.h"
+#include "frames/session_table.h"
+
+namespace Haptics {
+namespace Wireless {
+
+    /// Hosts that pinged us, see `Frames::SessionTable`. A periodic `/ping` keeps an otherwise quiet host.
+    /// The functions below lock the table, the receive task notes activity while loop() opens and
+    /// expires sessions. Only loop() writes a session's address and ports, so loop() may read
+    /// those through `sessions` or a returned pointer without the lock.
+    using Session = Frames::Session;
+
+    inline Frames::SessionTable sessions;
+
+    /// @brief Finds or adds the session for a pinging host, replacing the one its address already had.
+    /// @param sourcePort port the ping was sent from
+    /// @param port port the host asked us to reply to
+    Session *openSession(const IPAddress &ip, uint16_t sourcePort, uint16_t port, unsigned long now);
+
+    /// @brief Active session of the host at `ip`, nullptr if it never pinged or went silent.
+    Session *findSession(uint32_t ip);
+
+    /// @brief Keeps the sender's session alive, `motorFrame` also marks it as the one driving the motors.
+    /// Safe to call from any task.
+    void noteActivity(uint32_t ip, bool motorFrame);
+
+    /// @brief Whether a host at another address than `ip` sent motor frames within the session timeout.
+    bool otherHostStreaming(const IPAddress &ip, unsigned long now);
+
+    /// @brief The session that most recently sent a motor frame, nullptr if none did.
+    const Session *motorSession();
+
+    /// @brief Drops sessions that have been silent for `SESSION_TIMEOUT_MS`.
+    void expireSessions(unsigned long now);
+
+} // namespace Wireless
+} // namespace Haptics
+
+#endif // SESSIONS_H
@@ -0,0 +1,86 @@
+// Host tests for the motor frame decoders: pio test -e native -f test_codec
+#include <unity.h>
+#include <string.h>
+
+#include "software_defines.h"
+#include "frames/codec.h"
+
+using namespace Haptics::Frames;
+
+static const size_t MOTORS = MAX_MOTORS;
+
+void setUp() {}
+void tearDown() {}
+
+void test_sparse_applies_pairs()
+{
+    uint16_t out[MOTORS] = {};
+    const uint8_t pairs[] = {0x00, 0x02, 0x12, 0x34, 0x00, 0x05, 0xFF, 0xFF};
+    TEST_ASSERT_EQUAL(2, decodeSparse16(pairs, sizeof(pairs), out, MOTORS));
+    TEST_ASSERT_EQUAL(0x1234, out[2]);
+    TEST_ASSERT_EQUAL(0xFFFF, out[5]);
+    TEST_ASSERT_EQUAL(0, out[0]);
+}
+
+void test_sparse_rejects_malformed()
+{
+    uint16_t out[MOTORS] = {};
+    const uint8_t uneven[] = {0x00, 0x01, 0x12};
+    TEST_ASSERT_EQUAL(0, decodeSparse16(uneven, sizeof(uneven), out, MOTORS));
+    TEST_ASSERT_FALSE(isKeepalive(FRAME_SPARSE16, sizeof(uneven)));
+
+    // an index past the motors rejects the whole update, nothing is written
+    const uint8_t outside[] = {0x00, 0x01, 0x12, 0x34, 0xFF, 0x00, 0x00, 0x01};
+    TEST_ASSERT_EQUAL(0, decodeSparse16(outside, sizeof(outside), out, MOTORS));
+    TEST_ASSERT_EQUAL(0, out[1]);
+}
+
+void test_empty_sparse_is_keepalive()
+{
+    uint16_t out[MOTORS] = {};
+    out[3] = 0x4000;
+    const uint8_t empty[1] = {};
+    TEST_ASSERT_EQUAL(0, decodeSparse16(empty, 0, out, MOTORS));
+    TEST_ASSERT_EQUAL(0x4000, out[3]);
+
+    TEST_ASSERT_TRUE(isKeepalive(FRAME_SPARSE16, 0));
+    TEST_ASSERT_FALSE(isKeepalive(FRAME_SPARSE16, 4));
+    TEST_ASSERT_FALSE(isKeepalive(FRAME_BLOB16, 0));
+    TEST_ASSERT_FALSE(isKeepalive(FRAME_HEX16, 0));
+}
+
+void test_keepalive_packet_parses()
+{
+    // /hs with an empty blob and sequence number 7, what an idle delta host sends
+    const uint8_t packet[] = {'/', 'h', 's', 0, ',', 'b', 'i', 0, 0, 0, 0, 0, 0, 0, 0, 7};
+    RawMotorMessage frame;
+    TEST_ASSERT_TRUE(parseRawMotorMessage(packet, sizeof(packet), frame));
+    TEST_ASSERT_EQUAL(FRAME_SPARSE16, frame.kind);
+    TEST_ASSERT_EQUAL(0, frame.payloadLen);
+    TEST_ASSERT_TRUE(frame.hasSequence);
+    TEST_ASSERT_EQUAL(7, frame.sequence);
+    TEST_ASSERT_TRUE(isKeepalive(frame.kind, frame.payloadLen));
+}
+
+void test_sparse_slice_outside_is_empty()
+{
+    // on the shared stream, pairs for other boards slice down to an empty update
+    uint8_t pairs[] = {0x00, 0x01, 0x12, 0x34, 0x00, 0x20, 0x56, 0x78};
+    TEST_ASSERT_EQUAL(0, sliceFrame(FRAME_SPARSE16, pairs, sizeof(pairs), 8, 8));
+
+    uint8_t mine[] = {0x00, 0x01, 0x12, 0x34, 0x00, 0x09, 0x56, 0x78};
+    TEST_ASSERT_EQUAL(4, sliceFrame(FRAME_SPARSE16, mine, sizeof(mine), 8, 8));
+    TEST_ASSERT_EQUAL(0x00, mine[0]);
+    TEST_ASSERT_EQUAL(0x01, mine[1]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_sparse_applies_pairs);
+    RUN_TEST(test_sparse_rejects_malformed);
+    RUN_TEST(test_empty_sparse_is_keepalive);
+    RUN_TEST(test_keepalive_packet_parses);
+    RUN_TEST(test_sparse_slice_outside_is_empty);
+    return UNITY_END();
+}
@@ -0,0 +1,232 @@
+// Host benchmark of the motor frame decoders: pio test -e native -f test_decode_bench -v
+#include <unity.h>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "software_defines.h"
+#include "frames/codec.h"
+#include "frames/receiver.h"
+
+using namespace Haptics::Frames;
+
+static const size_t MOTOR_COUNTS[] = {16, 64, 128};
+static const int ITERATIONS = 200000;
+static const size_t MOTORS = MAX_MOTORS;
+
+/// @brief The decoder `/h` frames used before the lookup table: the OSC argument copied into a
+/// String, then into a char array, then every 4 character snippet through strtol.
+/// std::string stands in for Arduino's String, both allocate and copy the same way.
+static size_t decodeHexStrtol(const char *arg, size_t argLen, uint16_t *out)
+{
+    std::string msg_str(arg, argLen);
+    const int msg_length = msg_str.length();
+    char msg_char[msg_length + 1];
+    memcpy(msg_char, msg_str.c_str(), msg_length + 1);
+
+    const uint8_t numElements = msg_length / OSC_MOTOR_CHAR_NUM;
+    char snippet[OSC_MOTOR_CHAR_NUM + 1];
+    for (uint16_t i = 0; i < numElements; i++)
+    {
+        memcpy(snippet, &msg_char[OSC_MOTOR_CHAR_NUM * i], OSC_MOTOR_CHAR_NUM);
+        snippet[OSC_MOTOR_CHAR_NUM] = '\0';
+        out[i] = strtol(snippet, NULL, 16);
+    }
+    return numElements;
+}
+
+/// @brief A frame of `motors` random values, as hex text and as a big-endian blob.
+static void makeFrame(size_t motors, std::string &hex, uint8_t *blob)
+{
+    hex.clear();
+    for (size_t i = 0; i < motors; i++)
+    {
+        const uint16_t value = rand() & 0xFFFF;
+        char digits[5];
+        snprintf(digits, sizeof(digits), "%04X", value);
+        hex += digits;
+        blob[i * 2] = value >> 8;
+        blob[i * 2 + 1] = value & 0xFF;
+    }
+}
+
+/// @brief Average nanoseconds per call of `decode` over `ITERATIONS` calls.
+template <typename Decode>
+static double nsPerFrame(Decode decode)
+{
+    volatile uint16_t sink = 0;
+    const auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < ITERATIONS; i++)
+        sink += decode();
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    (void)sink;
+    return std::chrono::duration<double, std::nano>(elapsed).count() / ITERATIONS;
+}
+
+void setUp() { srand(1); }
+void tearDown() {}
+
+void test_decoders_agree()
+{
+    for (size_t motors : MOTOR_COUNTS)
+    {
+        std::string hex;
+        uint8_t blob[MOTORS * 2];
+        makeFrame(motors, hex, blob);
+
+        uint16_t expected[MOTORS] = {};
+        uint16_t actual[MOTORS] = {};
+        TEST_ASSERT_EQUAL(motors, decodeHexStrtol(hex.data(), hex.size(), expected));
+        TEST_ASSERT_EQUAL(motors, decodeHex16(hex.data(), hex.size(), actual, MOTORS));
+        TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, actual, motors);
+
+        TEST_ASSERT_EQUAL(motors, decodeBlob16(blob, motors * 2, actual, MOTORS));
+        TEST_ASSERT_EQUAL_UINT16_ARRAY(expected, actual, motors);
+    }
+}
+
+void test_bench_decode()
+{
+    printf("motors | /h strtol ns | /h table ns | speedup | /hb blob ns\n");
+    for (size_t motors : MOTOR_COUNTS)
+    {
+        std::string hex;
+        uint8_t blob[MOTORS * 2];
+        makeFrame(motors, hex, blob);
+        uint16_t out[MOTORS];
+
+        const double strtolNs = nsPerFrame([&] { decodeHexStrtol(hex.data(), hex.size(), out); return out[motors - 1]; });
+        const double tableNs = nsPerFrame([&] { decodeHex16(hex.data(), hex.size(), out, MOTORS); return out[motors - 1]; });
+        const double blobNs = nsPerFrame([&] { decodeBlob16(blob, motors * 2, out, MOTORS); return out[motors - 1]; });
+        printf("%6zu | %12.1f | %11.1f | %6.1fx | %11.1f\n", motors, strtolNs, tableNs, strtolNs / tableNs, blobNs);
+    }
+}
+
+/// @brief Appends `text` as a padded OSC string.
+static void putString(std::vector<uint8_t> &out, const char *text)
+{
+    const size_t len = strlen(text) + 1;
+    out.insert(out.end(), text, text + len);
+    out.resize((out.size() + 3) & ~(size_t)3, 0);
+}
+
+static void put32(std::vector<uint8_t> &out, uint32_t value)
+{
+    const uint8_t bytes[4] = {(uint8_t)(value >> 24), (uint8_t)(value >> 16), (uint8_t)(value >> 8), (uint8_t)value};
+    out.insert(out.end(), bytes, bytes + 4);
+}
+
+/// @brief A whole OSC packet to `address` with a blob argument. Without a sequence number,
+/// every run of the same packet is applied rather than dropped as a duplicate.
+static std::vector<uint8_t> blobPacket(const char *address, const std::vector<uint8_t> &blob)
+{
+    std::vector<uint8_t> packet;
+    putString(packet, address);
+    putString(packet, ",b");
+    put32(packet, blob.size());
+    packet.insert(packet.end(), blob.begin(), blob.end());
+    packet.resize((packet.size() + 3) & ~(size_t)3, 0);
+    return packet;
+}
+
+/// The board's receive side and what it hands frames to.
+struct Device {
+    FrameBuffer frames;
+    PlayoutQueue playout;
+    ClockSync clock;
+    Receiver receiver{frames, playout, clock};
+
+    /// @brief A packet through the same `Receiver::receivePacket` the transports call, then the
+    /// output side takes what it was handed, so queued bundles don't overflow.
+    Receiver::Outcome dispatch(std::vector<uint8_t> &packet)
+    {
+        const char *command;
+        size_t commandLen;
+        const Receiver::Outcome outcome = receiver.receivePacket(packet.data(), packet.size(), false, 0, command, commandLen);
+        frames.acquire();
+        while (playout.peek())
+            playout.pop();
+        return outcome;
+    }
+};
+
+void test_bench_dispatch()
+{
+    uint16_t groups[MOTORS];
+    for (size_t i = 0; i < MOTORS; i++)
+        groups[i] = 1 << (i % 4);
+    static Device device;
+
+    printf("whole packets through the board's Receiver, ns per packet\n");
+    printf("motors |      /h |     /hb | /hs 1:4 |  /hq x4 |     /ht |  /hg x4\n");
+    for (size_t motors : MOTOR_COUNTS)
+    {
+        std::string hex;
+        uint8_t values[MOTORS * 2];
+        makeFrame(motors, hex, values);
+        const std::vector<uint8_t> blob(values, values + motors * 2);
+
+        std::vector<uint8_t> hexPacket;
+        putString(hexPacket, "/h");
+        putString(hexPacket, ",s");
+        putString(hexPacket, hex.c_str());
+
+        // every fourth motor changed
+        std::vector<uint8_t> sparse;
+        for (size_t i = 0; i < motors; i += 4)
+        {
+            sparse.push_back(i >> 8);
+            sparse.push_back(i & 0xFF);
+            sparse.push_back(values[i * 2]);
+            sparse.push_back(values[i * 2 + 1]);
+        }
+
+        std::vector<uint8_t> bundle = {4, 0, (uint8_t)(motors >> 8), (uint8_t)motors};
+        for (uint32_t frame = 0; frame < 4; frame++)
+        {
+            put32(bundle, frame * 8333);
+            bundle.insert(bundle.end(), blob.begin(), blob.end());
+        }
+
+        std::vector<uint8_t> timed;
+        put32(timed, 123456);
+        timed.insert(timed.end(), blob.begin(), blob.end());
+
+        std::vector<uint8_t> group;
+        for (uint8_t g = 0; g < 4; g++)
+        {
+            const uint8_t entry[6] = {0, (uint8_t)(1 << g), GROUP_SET, 0, 0x40, g};
+            group.insert(group.end(), entry, entry + 6);
+        }
+
+        std::vector<uint8_t> packets[] = {
+            hexPacket,
+            blobPacket("/hb", blob),
+            blobPacket("/hs", sparse),
+            blobPacket("/hq", bundle),
+            blobPacket("/ht", timed),
+            blobPacket("/hg", group),
+        };
+
+        device.receiver.configure(motors, 0, groups);
+        printf("%6zu", motors);
+        for (std::vector<uint8_t> &packet : packets)
+        {
+            TEST_ASSERT_EQUAL(Receiver::RECEIVE_OUTPUT, device.dispatch(packet));
+            printf(" | %7.1f", nsPerFrame([&] { return device.dispatch(packet); }));
+        }
+        printf("\n");
+    }
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_decoders_agree);
+    RUN_TEST(test_bench_decode);
+    RUN_TEST(test_bench_dispatch);
+    return UNITY_END();
+}
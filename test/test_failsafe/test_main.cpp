@@ -0,0 +1,102 @@
+// Host tests for the output failsafe: pio test -e native -f test_failsafe
+#include <unity.h>
+#include <string.h>
+
+#include "software_defines.h"
+#include "frames/codec.h"
+#include "frames/failsafe.h"
+
+using namespace Haptics::Frames;
+
+static const size_t MOTORS = MAX_MOTORS;
+static const uint32_t HOLD_US = 100000;
+static const uint32_t FADE_US = 200000;
+
+void setUp() {}
+void tearDown() {}
+
+void test_idle_before_first_frame()
+{
+    Failsafe failsafe;
+    uint16_t out[MOTORS] = {};
+    uint32_t dirty[MOTOR_BITMAP_WORDS] = {};
+    TEST_ASSERT_TRUE(failsafe.tripped());
+    TEST_ASSERT_FALSE(failsafe.update(1000000, HOLD_US, FADE_US, out, dirty, MOTORS));
+}
+
+void test_holds_then_fades()
+{
+    Failsafe failsafe;
+    uint16_t out[MOTORS] = {};
+    uint32_t dirty[MOTOR_BITMAP_WORDS] = {};
+    out[0] = 60000;
+    out[3] = 2000;
+    failsafe.feed(0);
+    TEST_ASSERT_FALSE(failsafe.tripped());
+
+    // a dropped frame or two is hidden by holding the last values
+    TEST_ASSERT_FALSE(failsafe.update(HOLD_US, HOLD_US, FADE_US, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL(60000, out[0]);
+    TEST_ASSERT_FALSE(failsafe.tripped());
+
+    // past the hold the fade starts from the held values
+    TEST_ASSERT_TRUE(failsafe.update(HOLD_US + FADE_US / 4, HOLD_US, FADE_US, out, dirty, MOTORS));
+    TEST_ASSERT_TRUE(failsafe.tripped());
+    TEST_ASSERT_EQUAL(45000, out[0]);
+    TEST_ASSERT_EQUAL(1500, out[3]);
+    TEST_ASSERT_TRUE(isDirty(dirty, 0));
+    TEST_ASSERT_FALSE(isDirty(dirty, 1));
+
+    // still scaled from the held values, not from the last step
+    failsafe.update(HOLD_US + FADE_US / 2, HOLD_US, FADE_US, out, dirty, MOTORS);
+    TEST_ASSERT_EQUAL(30000, out[0]);
+    TEST_ASSERT_EQUAL(1000, out[3]);
+}
+
+void test_fade_completes_at_zero()
+{
+    Failsafe failsafe;
+    uint16_t out[MOTORS] = {};
+    uint32_t dirty[MOTOR_BITMAP_WORDS] = {};
+    out[0] = 60000;
+    failsafe.feed(0);
+    failsafe.update(HOLD_US + 1, HOLD_US, FADE_US, out, dirty, MOTORS);
+
+    TEST_ASSERT_TRUE(failsafe.update(HOLD_US + FADE_US, HOLD_US, FADE_US, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL(0, out[0]);
+    TEST_ASSERT_TRUE(failsafe.tripped());
+
+    // once zeroed nothing more is written until the next frame
+    out[0] = 123;
+    TEST_ASSERT_FALSE(failsafe.update(HOLD_US + FADE_US + 5000, HOLD_US, FADE_US, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL(123, out[0]);
+
+    // a new frame makes the motors live again and restarts the hold
+    out[0] = 50000;
+    failsafe.feed(1000000);
+    TEST_ASSERT_FALSE(failsafe.tripped());
+    TEST_ASSERT_FALSE(failsafe.update(1000000 + HOLD_US, HOLD_US, FADE_US, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL(50000, out[0]);
+}
+
+void test_zero_fade_cuts_at_once()
+{
+    Failsafe failsafe;
+    uint16_t out[MOTORS] = {};
+    uint32_t dirty[MOTOR_BITMAP_WORDS] = {};
+    out[2] = 65535;
+    failsafe.feed(0);
+    TEST_ASSERT_TRUE(failsafe.update(HOLD_US + 1, HOLD_US, 0, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL(0, out[2]);
+    TEST_ASSERT_TRUE(failsafe.tripped());
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_idle_before_first_frame);
+    RUN_TEST(test_holds_then_fades);
+    RUN_TEST(test_fade_completes_at_zero);
+    RUN_TEST(test_zero_fade_cuts_at_once);
+    return UNITY_END();
+}
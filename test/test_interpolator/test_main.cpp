@@ -0,0 +1,118 @@
+// Host tests for the output interpolator: pio test -e native -f test_interpolator
+#include <unity.h>
+
+#include "software_defines.h"
+#include "frames/codec.h"
+#include "frames/interpolator.h"
+
+using namespace Haptics::Frames;
+
+static const size_t MOTORS = MAX_MOTORS;
+static const uint32_t MAX_RAMP_US = 20000;
+
+void setUp() {}
+void tearDown() {}
+
+void test_first_target_applies_at_once()
+{
+    Interpolator interpolator;
+    uint16_t target[MOTORS] = {};
+    uint16_t out[MOTORS] = {};
+    uint32_t dirty[MOTOR_BITMAP_WORDS] = {};
+    target[0] = 40000;
+    target[5] = 1000;
+
+    // without a previous target there is no interval to ramp over, durationUs is 0
+    interpolator.setTarget(target, out, MOTORS, 1000, MAX_RAMP_US);
+    TEST_ASSERT_TRUE(interpolator.step(1000, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL_UINT16_ARRAY(target, out, MOTORS);
+    TEST_ASSERT_FALSE(interpolator.ramping());
+    TEST_ASSERT_TRUE(isDirty(dirty, 0));
+    TEST_ASSERT_TRUE(isDirty(dirty, 5));
+    TEST_ASSERT_FALSE(isDirty(dirty, 1));
+
+    // nor is there for two targets at the same time
+    target[0] = 0;
+    interpolator.setTarget(target, out, MOTORS, 1000, MAX_RAMP_US);
+    TEST_ASSERT_TRUE(interpolator.step(1000, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL(0, out[0]);
+    TEST_ASSERT_FALSE(interpolator.ramping());
+}
+
+void test_ramps_over_target_interval()
+{
+    Interpolator interpolator;
+    uint16_t target[MOTORS] = {};
+    uint16_t out[MOTORS] = {};
+    uint32_t dirty[MOTOR_BITMAP_WORDS] = {};
+    out[1] = 50000;
+    interpolator.setTarget(out, out, MOTORS, 0, MAX_RAMP_US);
+    interpolator.step(0, out, dirty, MOTORS);
+
+    // targets 10ms apart, the ramp takes 10ms, up for motor 0 and down for motor 1
+    target[0] = 20000;
+    target[1] = 10000;
+    interpolator.setTarget(target, out, MOTORS, 10000, MAX_RAMP_US);
+    TEST_ASSERT_TRUE(interpolator.ramping());
+
+    TEST_ASSERT_TRUE(interpolator.step(15000, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL(10000, out[0]);
+    TEST_ASSERT_EQUAL(30000, out[1]);
+    TEST_ASSERT_TRUE(interpolator.ramping());
+
+    TEST_ASSERT_TRUE(interpolator.step(20000, out, dirty, MOTORS));
+    TEST_ASSERT_EQUAL(20000, out[0]);
+    TEST_ASSERT_EQUAL(10000, out[1]);
+    TEST_ASSERT_FALSE(interpolator.ramping());
+
+    // nothing left to do
+    TEST_ASSERT_FALSE(interpolator.step(22000, out, dirty, MOTORS));
+}
+
+void test_max_ramp_clamps_slow_hosts()
+{
+    Interpolator interpolator;
+    uint16_t target[MOTORS] = {};
+    uint16_t out[MOTORS] = {};
+    uint32_t dirty[MOTOR_BITMAP_WORDS] = {};
+    interpolator.setTarget(out, out, MOTORS, 0, MAX_RAMP_US);
+    interpolator.step(0, out, dirty, MOTORS);
+
+    // a host sending every 100ms still reaches each target within MAX_RAMP_US
+    target[0] = 40000;
+    interpolator.setTarget(target, out, MOTORS, 100000, MAX_RAMP_US);
+    interpolator.step(100000 + MAX_RAMP_US / 2, out, dirty, MOTORS);
+    TEST_ASSERT_EQUAL(20000, out[0]);
+    interpolator.step(100000 + MAX_RAMP_US, out, dirty, MOTORS);
+    TEST_ASSERT_EQUAL(40000, out[0]);
+    TEST_ASSERT_FALSE(interpolator.ramping());
+}
+
+void test_stop_forgets_interval()
+{
+    Interpolator interpolator;
+    uint16_t target[MOTORS] = {};
+    uint16_t out[MOTORS] = {};
+    uint32_t dirty[MOTOR_BITMAP_WORDS] = {};
+    interpolator.setTarget(out, out, MOTORS, 0, MAX_RAMP_US);
+    target[0] = 30000;
+    interpolator.setTarget(target, out, MOTORS, 10000, MAX_RAMP_US);
+    interpolator.stop();
+    TEST_ASSERT_FALSE(interpolator.ramping());
+    TEST_ASSERT_FALSE(interpolator.step(15000, out, dirty, MOTORS));
+
+    // the failsafe stopped it, the next frame after the gap applies at once
+    interpolator.setTarget(target, out, MOTORS, 500000, MAX_RAMP_US);
+    interpolator.step(500000, out, dirty, MOTORS);
+    TEST_ASSERT_EQUAL(30000, out[0]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_target_applies_at_once);
+    RUN_TEST(test_ramps_over_target_interval);
+    RUN_TEST(test_max_ramp_clamps_slow_hosts);
+    RUN_TEST(test_stop_forgets_interval);
+    return UNITY_END();
+}
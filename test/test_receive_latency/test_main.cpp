@@ -0,0 +1,193 @@
+// Receive to decoded latency of the 7ms OscWiFi.update() poll against a receive task
+// blocked in select(), over loopback UDP: pio test -e native -f test_receive_latency -v
+// A host model, not a board measurement: only the receive side is modelled, the network and
+// the output path add the same to both. On the boards only the fast port and the shared stream
+// are read by the receive task, the OSC port (`/h`, `/hb` ...) is still polled every 7ms.
+// Needs POSIX sockets, on Windows hosts it only reports that it was skipped.
+#include <unity.h>
+
+#if !defined(_WIN32)
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include "software_defines.h"
+#include "frames/codec.h"
+
+using namespace Haptics::Frames;
+
+static const uint32_t FRAMES = 300;
+static const size_t FRAME_MOTORS = 16;
+/// loop() only calls `Wireless::Tick()` once this many ms have passed
+static const int POLL_PERIOD_MS = 7;
+
+/// receivers give up on frames that haven't arrived by then
+static const int64_t TIMEOUT_NS = 10000000000LL;
+
+static std::atomic<int64_t> sentNs[FRAMES];
+
+static int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+/// @brief An OSC `/hb` frame of `FRAME_MOTORS` values with sequence number `seq`.
+static size_t buildFrame(uint8_t *out, uint32_t seq)
+{
+    size_t len = 0;
+    memcpy(out, "/hb\0,bi\0", 8);
+    len += 8;
+    const uint32_t blobLen = FRAME_MOTORS * 2;
+    const uint8_t sizeBytes[4] = {0, 0, 0, (uint8_t)blobLen};
+    memcpy(out + len, sizeBytes, 4);
+    len += 4;
+    for (size_t i = 0; i < FRAME_MOTORS; i++)
+    {
+        out[len++] = (uint8_t)(seq >> 8);
+        out[len++] = (uint8_t)seq;
+    }
+    const uint8_t seqBytes[4] = {(uint8_t)(seq >> 24), (uint8_t)(seq >> 16), (uint8_t)(seq >> 8), (uint8_t)seq};
+    memcpy(out + len, seqBytes, 4);
+    return len + 4;
+}
+
+/// @brief Decodes one received packet and records how long after its send it was decoded.
+static void decodePacket(uint8_t *packet, size_t len, uint16_t *vals, std::vector<uint32_t> &latencyUs)
+{
+    RawMotorMessage frame;
+    if (!parseRawMotorMessage(packet, len, frame) || !frame.hasSequence || frame.sequence >= FRAMES)
+        return;
+    if (decodeFrame(frame.kind, frame.payload, frame.payloadLen, vals, MAX_MOTORS) == 0)
+        return;
+    latencyUs.push_back((uint32_t)((nowNs() - sentNs[frame.sequence].load()) / 1000));
+}
+
+/// @brief The OSC port's receive side: loop() spins and drains the socket once every `POLL_PERIOD_MS`.
+static void pollReceiver(int sock, std::vector<uint32_t> &latencyUs)
+{
+    fcntl(sock, F_SETFL, O_NONBLOCK);
+    uint8_t packet[FAST_PATH_BUFFER_SIZE];
+    uint16_t vals[MAX_MOTORS];
+    int64_t lastTick = nowNs();
+    const int64_t deadline = lastTick + TIMEOUT_NS;
+    while (latencyUs.size() < FRAMES && nowNs() < deadline)
+    {
+        // one loop() pass without the tick
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+        if (nowNs() - lastTick < POLL_PERIOD_MS * 1000000LL)
+            continue;
+        lastTick = nowNs();
+
+        ssize_t len;
+        while ((len = recv(sock, packet, sizeof(packet), 0)) > 0)
+            decodePacket(packet, len, vals, latencyUs);
+    }
+}
+
+/// @brief The fast port's receive task: blocks in select() and decodes each packet as it arrives.
+static void blockingReceiver(int sock, std::vector<uint32_t> &latencyUs)
+{
+    uint8_t packet[FAST_PATH_BUFFER_SIZE];
+    uint16_t vals[MAX_MOTORS];
+    const int64_t deadline = nowNs() + TIMEOUT_NS;
+    while (latencyUs.size() < FRAMES && nowNs() < deadline)
+    {
+        fd_set readable;
+        FD_ZERO(&readable);
+        FD_SET(sock, &readable);
+        timeval timeout = {0, 100000};
+        if (select(sock + 1, &readable, nullptr, nullptr, &timeout) <= 0)
+            continue;
+        const ssize_t len = recv(sock, packet, sizeof(packet), 0);
+        if (len > 0)
+            decodePacket(packet, len, vals, latencyUs);
+    }
+}
+
+/// @brief Sends `FRAMES` frames at irregular 3-11ms intervals, like a host that isn't in step with the board.
+/// @return each frame's send to decode latency in microseconds, sorted
+template <typename Receiver>
+static std::vector<uint32_t> measure(Receiver receiver)
+{
+    const int rx = socket(AF_INET, SOCK_DGRAM, 0);
+    const int tx = socket(AF_INET, SOCK_DGRAM, 0);
+    sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrLen = sizeof(addr);
+    bind(rx, (sockaddr *)&addr, sizeof(addr));
+    getsockname(rx, (sockaddr *)&addr, &addrLen);
+
+    std::vector<uint32_t> latencyUs;
+    latencyUs.reserve(FRAMES);
+    std::thread thread(receiver, rx, std::ref(latencyUs));
+
+    std::mt19937 random(1);
+    std::uniform_int_distribution<int> gapUs(3000, 11000);
+    uint8_t packet[64];
+    for (uint32_t seq = 0; seq < FRAMES; seq++)
+    {
+        std::this_thread::sleep_for(std::chrono::microseconds(gapUs(random)));
+        const size_t len = buildFrame(packet, seq);
+        sentNs[seq].store(nowNs());
+        sendto(tx, packet, len, 0, (sockaddr *)&addr, sizeof(addr));
+    }
+    thread.join();
+    close(rx);
+    close(tx);
+
+    std::sort(latencyUs.begin(), latencyUs.end());
+    return latencyUs;
+}
+
+static void print(const char *name, const std::vector<uint32_t> &sorted)
+{
+    if (sorted.empty())
+        return;
+    const auto at = [&](double quantile) { return sorted[(size_t)(quantile * (sorted.size() - 1))]; };
+    printf("%-16s median %5u us  p90 %5u us  p99 %5u us  max %5u us\n", name, at(0.5), at(0.9), at(0.99), sorted.back());
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_receive_latency()
+{
+    const std::vector<uint32_t> polled = measure(pollReceiver);
+    const std::vector<uint32_t> blocking = measure(blockingReceiver);
+    print("7ms poll", polled);
+    print("blocking task", blocking);
+
+    TEST_ASSERT_EQUAL(FRAMES, polled.size());
+    TEST_ASSERT_EQUAL(FRAMES, blocking.size());
+    TEST_ASSERT_TRUE(blocking[FRAMES / 2] < polled[FRAMES / 2]);
+}
+
+#else
+void setUp() {}
+void tearDown() {}
+
+void test_receive_latency()
+{
+    TEST_MESSAGE("needs POSIX sockets, skipped");
+}
+#endif
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_receive_latency);
+    return UNITY_END();
+}
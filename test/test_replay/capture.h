@@ -0,0 +1,92 @@
+// Generated by make_capture.py, do not edit.
+#pragma once
+
+#include <stdint.h>
+
+static const uint8_t CAPTURE[] = {
+    0xd4, 0xc3, 0xb2, 0xa1, 0x02, 0x00, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0xff, 0xff, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0xf1, 0x53, 0x65, 0x00, 0x00, 0x00, 0x00,
+    0x7a, 0x00, 0x00, 0x00, 0x7a, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x45, 0x00, 0x00, 0x6c, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11,
+    0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x04, 0x00, 0x58,
+    0x00, 0x00, 0x2f, 0x68, 0x00, 0x00, 0x2c, 0x73, 0x69, 0x00, 0x30, 0x30, 0x30, 0x30, 0x31, 0x30,
+    0x30, 0x30, 0x32, 0x30, 0x30, 0x30, 0x33, 0x30, 0x30, 0x30, 0x34, 0x30, 0x30, 0x30, 0x35, 0x30,
+    0x30, 0x30, 0x36, 0x30, 0x30, 0x30, 0x37, 0x30, 0x30, 0x30, 0x38, 0x30, 0x30, 0x30, 0x39, 0x30,
+    0x30, 0x30, 0x41, 0x30, 0x30, 0x30, 0x42, 0x30, 0x30, 0x30, 0x43, 0x30, 0x30, 0x30, 0x44, 0x30,
+    0x30, 0x30, 0x45, 0x30, 0x30, 0x30, 0x46, 0x30, 0x30, 0x30, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0xf1, 0x53, 0x65, 0x35, 0x82, 0x00, 0x00, 0x5a, 0x00, 0x00, 0x00, 0x5a, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00,
+    0x45, 0x00, 0x00, 0x4c, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a,
+    0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x04, 0x00, 0x38, 0x00, 0x00, 0x2f, 0x68, 0x62, 0x00,
+    0x2c, 0x62, 0x69, 0x00, 0x00, 0x00, 0x00, 0x20, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00,
+    0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00,
+    0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0xf1, 0x53, 0x65,
+    0x6a, 0x04, 0x01, 0x00, 0x5a, 0x00, 0x00, 0x00, 0x5a, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x45, 0x00, 0x00, 0x4c, 0x00, 0x00,
+    0x00, 0x00, 0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50,
+    0x04, 0x04, 0x00, 0x38, 0x00, 0x00, 0x2f, 0x68, 0x62, 0x00, 0x2c, 0x62, 0x69, 0x00, 0x00, 0x00,
+    0x00, 0x20, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00,
+    0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00, 0x80, 0x00,
+    0x80, 0x00, 0x00, 0x00, 0x00, 0x02, 0x00, 0xf1, 0x53, 0x65, 0x9f, 0x86, 0x01, 0x00, 0x42, 0x00,
+    0x00, 0x00, 0x42, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x10, 0x08, 0x00, 0x45, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00,
+    0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x04, 0x00, 0x20, 0x00, 0x00,
+    0x2f, 0x68, 0x73, 0x00, 0x2c, 0x62, 0x69, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x01, 0x00,
+    0x00, 0x0f, 0xff, 0xff, 0x00, 0x00, 0x00, 0x03, 0x00, 0xf1, 0x53, 0x65, 0xd4, 0x08, 0x02, 0x00,
+    0x5a, 0x00, 0x00, 0x00, 0x5a, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00,
+    0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x45, 0x00, 0x00, 0x4c, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11,
+    0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x04, 0x00, 0x38,
+    0x00, 0x00, 0x2f, 0x68, 0x62, 0x00, 0x2c, 0x62, 0x69, 0x00, 0x00, 0x00, 0x00, 0x20, 0x40, 0x00,
+    0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00,
+    0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x40, 0x00, 0x00, 0x00,
+    0x00, 0x06, 0x00, 0xf1, 0x53, 0x65, 0x09, 0x8b, 0x02, 0x00, 0xaa, 0x00, 0x00, 0x00, 0xaa, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00,
+    0x45, 0x00, 0x00, 0x9c, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a,
+    0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x04, 0x00, 0x88, 0x00, 0x00, 0x2f, 0x68, 0x71, 0x00,
+    0x2c, 0x62, 0x69, 0x00, 0x00, 0x00, 0x00, 0x70, 0x03, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x00,
+    0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00,
+    0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00, 0x10, 0x00,
+    0x00, 0x00, 0x27, 0x10, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x00, 0x00, 0x4e, 0x20, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00,
+    0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x30, 0x00, 0x00, 0x00, 0x00, 0x07, 0x00, 0xf1, 0x53, 0x65,
+    0x3e, 0x0d, 0x03, 0x00, 0x66, 0x00, 0x00, 0x00, 0x66, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x45, 0x00, 0x00, 0x58, 0x00, 0x00,
+    0x00, 0x00, 0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50,
+    0x04, 0x04, 0x00, 0x44, 0x00, 0x00, 0x2f, 0x68, 0x74, 0x00, 0x2c, 0x62, 0x69, 0x69, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x00, 0x01, 0xe2, 0x40, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00,
+    0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x20, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00,
+    0x00, 0x2a, 0x00, 0xf1, 0x53, 0x65, 0x73, 0x8f, 0x03, 0x00, 0x42, 0x00, 0x00, 0x00, 0x42, 0x00,
+    0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00,
+    0x45, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a,
+    0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x04, 0x00, 0x20, 0x00, 0x00, 0x2f, 0x68, 0x67, 0x00,
+    0x2c, 0x62, 0x69, 0x00, 0x00, 0x00, 0x00, 0x06, 0x00, 0x01, 0x00, 0x00, 0x30, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x09, 0x00, 0xf1, 0x53, 0x65, 0xa8, 0x11, 0x04, 0x00, 0x42, 0x00, 0x00, 0x00,
+    0x42, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x00, 0x10,
+    0x08, 0x00, 0x45, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8,
+    0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x03, 0x00, 0x20, 0x00, 0x00, 0x2f, 0x68,
+    0x62, 0x00, 0x2c, 0x62, 0x69, 0x00, 0x00, 0x00, 0x00, 0x06, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x0a, 0x00, 0xf1, 0x53, 0x65, 0xdd, 0x93, 0x04, 0x00, 0x3a, 0x00,
+    0x00, 0x00, 0x3a, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x10, 0x08, 0x00, 0x45, 0x00, 0x00, 0x2c, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00,
+    0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x04, 0x00, 0x18, 0x00, 0x00,
+    0x2f, 0x68, 0x73, 0x00, 0x2c, 0x62, 0x69, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0b,
+    0x00, 0xf1, 0x53, 0x65, 0x12, 0x16, 0x05, 0x00, 0x46, 0x00, 0x00, 0x00, 0x46, 0x00, 0x00, 0x00,
+    0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x45, 0x00,
+    0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8,
+    0x01, 0x32, 0xc3, 0x50, 0x04, 0x03, 0x00, 0x24, 0x00, 0x00, 0x2f, 0x63, 0x6f, 0x6d, 0x6d, 0x61,
+    0x6e, 0x64, 0x00, 0x00, 0x00, 0x00, 0x2c, 0x73, 0x00, 0x00, 0x47, 0x45, 0x54, 0x20, 0x4c, 0x41,
+    0x54, 0x45, 0x4e, 0x43, 0x59, 0x00, 0x00, 0xf1, 0x53, 0x65, 0x47, 0x98, 0x05, 0x00, 0x36, 0x00,
+    0x00, 0x00, 0x36, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00, 0x00, 0x50, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x10, 0x08, 0x00, 0x45, 0x00, 0x00, 0x28, 0x00, 0x00, 0x00, 0x00, 0x40, 0x11, 0x00, 0x00,
+    0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50, 0x04, 0x04, 0x00, 0x14, 0x00, 0x00,
+    0x2f, 0x68, 0x62, 0x00, 0x2c, 0x62, 0x00, 0x00, 0x00, 0x00, 0x00, 0x40, 0x00, 0xf1, 0x53, 0x65,
+    0x7c, 0x1a, 0x06, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
+    0x00, 0x50, 0x02, 0x00, 0x00, 0x00, 0x00, 0x10, 0x08, 0x00, 0x45, 0x00, 0x00, 0x3c, 0x00, 0x00,
+    0x00, 0x00, 0x40, 0x11, 0x00, 0x00, 0xc0, 0xa8, 0x01, 0x0a, 0xc0, 0xa8, 0x01, 0x32, 0xc3, 0x50,
+    0x14, 0xe9, 0x00, 0x28, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
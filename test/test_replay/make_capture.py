@@ -0,0 +1,66 @@
+#!/usr/bin/env python3
+"""Writes capture.h, the pcap test_replay replays when REPLAY_PCAP isn't set.
+
+Every motor frame layout plus a command, a duplicate, a sequence gap, a malformed
+packet and unrelated traffic, as Ethernet/IPv4/UDP frames like tcpdump records them.
+"""
+import struct
+
+HOST, DEVICE = bytes([192, 168, 1, 10]), bytes([192, 168, 1, 50])
+RECEIVE_PORT, FAST_PORT = 1027, 1028
+
+
+def osc_string(text):
+    data = text.encode() + b"\0"
+    return data + b"\0" * (-len(data) % 4)
+
+
+def osc_blob(data):
+    return struct.pack(">I", len(data)) + data + b"\0" * (-len(data) % 4)
+
+
+def message(address, payload, *ints):
+    tags = ("s" if isinstance(payload, str) else "b") + "i" * len(ints)
+    arg = osc_string(payload) if isinstance(payload, str) else osc_blob(payload)
+    return osc_string(address) + osc_string("," + tags) + arg + b"".join(struct.pack(">i", i) for i in ints)
+
+
+def blob16(values):
+    return b"".join(struct.pack(">H", v) for v in values)
+
+
+def udp_frame(payload, port):
+    udp = struct.pack(">HHHH", 50000, port, 8 + len(payload), 0) + payload
+    ip = struct.pack(">BBHHHBBH4s4s", 0x45, 0, 20 + len(udp), 0, 0, 64, 17, 0, HOST, DEVICE)
+    return b"\x02\0\0\0\0\x50" + b"\x02\0\0\0\0\x10" + b"\x08\x00" + ip + udp
+
+
+ramp = [i * 0x1000 for i in range(16)]
+packets = [
+    (message("/h", "".join("%04X" % v for v in ramp), 1), FAST_PORT),
+    (message("/hb", blob16([0x8000] * 16), 2), FAST_PORT),
+    (message("/hb", blob16([0x8000] * 16), 2), FAST_PORT),  # duplicate
+    (message("/hs", blob16([0, 0x0100, 15, 0xFFFF]), 3), FAST_PORT),
+    (message("/hb", blob16([0x4000] * 16), 6), FAST_PORT),  # frames 4 and 5 lost
+    (message("/hq", bytes([3, 0]) + struct.pack(">H", 16)
+             + b"".join(struct.pack(">I", 10000 * i) + blob16([0x1000 * (i + 1)] * 16) for i in range(3)), 7), FAST_PORT),
+    (message("/ht", struct.pack(">I", 123456) + blob16([0x2000] * 16), 8, 42), FAST_PORT),
+    (message("/hg", struct.pack(">HBBH", 1, 0, 0, 0x3000), 9), FAST_PORT),
+    (message("/hb", blob16([0x0101] * 3), 10), RECEIVE_PORT),
+    (message("/hs", b"", 11), FAST_PORT),  # keepalive, nothing changed
+    (osc_string("/command") + osc_string(",s") + osc_string("GET LATENCY"), RECEIVE_PORT),
+    (b"/hb\0,b\0\0\0\0\0\x40", FAST_PORT),  # blob longer than the packet
+    (b"\0" * 32, 5353),  # someone else's traffic
+]
+
+pcap = struct.pack("<IHHiIII", 0xA1B2C3D4, 2, 4, 0, 0, 65535, 1)
+for i, (payload, port) in enumerate(packets):
+    frame = udp_frame(payload, port)
+    pcap += struct.pack("<IIII", 1700000000, i * 33333, len(frame), len(frame)) + frame
+
+with open("capture.h", "w") as out:
+    out.write("// Generated by make_capture.py, do not edit.\n#pragma once\n\n#include <stdint.h>\n\n")
+    out.write("static const uint8_t CAPTURE[] = {\n")
+    for i in range(0, len(pcap), 16):
+        out.write("    " + ", ".join("0x%02x" % b for b in pcap[i:i + 16]) + ",\n")
+    out.write("};\n")
@@ -0,0 +1,241 @@
+// Replays recorded motor traffic through the device's decode path and times every packet.
+//   pio test -e native -f test_replay -v
+// Replays capture.h by default. To replay your own host, record it with
+//   tcpdump -i <interface> -w capture.pcap udp port 1027 or udp port 1028 or udp port 6869
+// and run with REPLAY_PCAP=capture.pcap.
+#include <unity.h>
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include "software_defines.h"
+#include "frames/codec.h"
+#include "frames/receiver.h"
+#include "capture.h"
+
+using namespace Haptics::Frames;
+
+static const size_t MOTORS = MAX_MOTORS;
+
+/// The board's receive side and what it hands frames to, without the transports.
+struct Replay {
+    FrameBuffer frames;
+    PlayoutQueue playout;
+    ClockSync clock;
+    Receiver receiver{frames, playout, clock};
+    uint32_t packets = 0;
+    uint32_t commands = 0;
+    /// @brief Decode time of every packet that reached the decoder.
+    std::vector<uint32_t> decodeNs;
+};
+
+/// @brief Runs a packet through the same `Receiver::receivePacket` every transport on the board calls.
+/// @param shared whether it was sent to the shared stream port
+static void dispatch(Replay &replay, uint8_t *packet, size_t len, bool shared)
+{
+    const char *command;
+    size_t commandLen;
+    if (replay.receiver.receivePacket(packet, len, shared, 0, command, commandLen) == Receiver::RECEIVE_COMMAND)
+        replay.commands++;
+    // the output side takes what it was handed, so bundles don't fill the playout queue
+    replay.frames.acquire();
+    while (replay.playout.peek())
+        replay.playout.pop();
+}
+
+static uint16_t read16(const uint8_t *data) { return (data[0] << 8) | data[1]; }
+
+/// @brief Finds the UDP payload in one captured link-layer frame.
+/// @param linkType the capture's LINKTYPE_ value
+/// @param port filled with the destination port
+/// @return false for anything but an unfragmented IPv4 UDP packet to one of the motor ports
+static bool udpPayload(uint32_t linkType, const uint8_t *data, size_t len, const uint8_t *&payload, size_t &payloadLen, uint16_t &port)
+{
+    size_t ip = 0;
+    uint16_t etherType = 0x0800;
+    switch (linkType)
+    {
+    case 0: // BSD loopback, 4 byte address family
+        ip = 4;
+        break;
+    case 1: // Ethernet, possibly VLAN tagged
+        if (len < 14)
+            return false;
+        ip = 14;
+        etherType = read16(data + 12);
+        if (etherType == 0x8100 && len >= 18)
+        {
+            etherType = read16(data + 16);
+            ip = 18;
+        }
+        break;
+    case 101: // raw IP
+        break;
+    case 113: // Linux cooked capture, tcpdump -i any
+        if (len < 16)
+            return false;
+        ip = 16;
+        etherType = read16(data + 14);
+        break;
+    default:
+        return false;
+    }
+    if (etherType != 0x0800 || len < ip + 20 || (data[ip] >> 4) != 4 || data[ip + 9] != 17)
+        return false;
+    if (read16(data + ip + 6) & 0x3FFF) // fragment
+        return false;
+
+    const size_t udp = ip + (data[ip] & 0x0F) * 4;
+    if (len < udp + 8)
+        return false;
+    port = read16(data + udp + 2);
+    if (port != RECIEVE_PORT && port != MOTOR_FAST_PORT && port != MOTOR_STREAM_PORT)
+        return false;
+    const size_t udpLen = read16(data + udp + 4);
+    if (udpLen < 8 || udp + udpLen > len)
+        return false;
+
+    payload = data + udp + 8;
+    payloadLen = udpLen - 8;
+    return true;
+}
+
+/// @brief Replays every motor port packet of a pcap capture.
+/// @return false if `capture` isn't a pcap file
+static bool replayCapture(Replay &replay, const uint8_t *capture, size_t len)
+{
+    if (len < 24)
+        return false;
+    uint32_t magic;
+    memcpy(&magic, capture, 4);
+    if (magic != 0xA1B2C3D4 && magic != 0xA1B23C4D)
+        return false; // only little-endian host captures, what tcpdump writes on x86 and ARM
+    uint32_t linkType;
+    memcpy(&linkType, capture + 20, 4);
+
+    // the decoders work in place on the device, so each packet gets its own copy here too
+    static uint8_t packet[FAST_PATH_BUFFER_SIZE];
+    size_t offset = 24;
+    while (offset + 16 <= len)
+    {
+        uint32_t capturedLen;
+        memcpy(&capturedLen, capture + offset + 8, 4);
+        offset += 16;
+        if (capturedLen > len - offset)
+            break;
+
+        const uint8_t *payload;
+        size_t payloadLen;
+        uint16_t port;
+        if (udpPayload(linkType, capture + offset, capturedLen, payload, payloadLen, port) && payloadLen <= sizeof(packet))
+        {
+            memcpy(packet, payload, payloadLen);
+            replay.packets++;
+            const auto start = std::chrono::steady_clock::now();
+            dispatch(replay, packet, payloadLen, port == MOTOR_STREAM_PORT);
+            const auto elapsed = std::chrono::steady_clock::now() - start;
+            replay.decodeNs.push_back((uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+        }
+        offset += capturedLen;
+    }
+    return true;
+}
+
+static void printTiming(const char *name, uint32_t packets, const std::vector<uint32_t> &decodeNs)
+{
+    std::vector<uint32_t> sorted = decodeNs;
+    std::sort(sorted.begin(), sorted.end());
+    const auto at = [&](double quantile) { return sorted.empty() ? 0 : sorted[(size_t)(quantile * (sorted.size() - 1))]; };
+    printf("%s: %u packets, decode ns median %u p99 %u max %u\n", name, (unsigned)packets, at(0.5), at(0.99), at(1));
+}
+
+static void printReplay(const char *name, const Replay &replay)
+{
+    printTiming(name, replay.packets, replay.decodeNs);
+    char stats[256];
+    formatStats(replay.receiver.stats(), stats, sizeof(stats));
+    printf("%u commands, %s\n", (unsigned)replay.commands, stats);
+}
+
+void setUp() {}
+void tearDown() {}
+
+void test_replay_fixture()
+{
+    static Replay replay;
+    // even motors in group 1, odd ones in group 2
+    uint16_t groups[MOTORS];
+    for (size_t i = 0; i < MOTORS; i++)
+        groups[i] = 1 << (i % 2);
+    replay.receiver.configure(MOTORS, 0, groups);
+
+    TEST_ASSERT_TRUE(replayCapture(replay, CAPTURE, sizeof(CAPTURE)));
+    printReplay("capture.h", replay);
+
+    TEST_ASSERT_EQUAL(12, replay.packets);
+    TEST_ASSERT_EQUAL(1, replay.commands);
+    TEST_ASSERT_EQUAL(11, replay.receiver.stats().received);
+    TEST_ASSERT_EQUAL(9, replay.receiver.stats().applied);
+    TEST_ASSERT_EQUAL(1, replay.receiver.stats().duplicates);
+    TEST_ASSERT_EQUAL(2, replay.receiver.stats().lost);
+    TEST_ASSERT_EQUAL(1, replay.receiver.stats().malformed);
+
+    // the short /hb set the first three, the group frame every even motor over the timed frame's values
+    for (size_t i = 0; i < 16; i++)
+        TEST_ASSERT_EQUAL(i < 3 ? 0x0101 : i % 2 == 0 ? 0x3000 : 0x2000, replay.receiver.values()[i]);
+    TEST_ASSERT_EQUAL(0x3000, replay.receiver.values()[16]);
+    TEST_ASSERT_EQUAL(0, replay.receiver.values()[17]);
+}
+
+void test_bench_replay()
+{
+    // one pass is too few packets to time, keep the decode times of many
+    uint32_t packets = 0;
+    std::vector<uint32_t> decodeNs;
+    for (int i = 0; i < 10000; i++)
+    {
+        Replay replay;
+        replayCapture(replay, CAPTURE, sizeof(CAPTURE));
+        packets += replay.packets;
+        decodeNs.insert(decodeNs.end(), replay.decodeNs.begin(), replay.decodeNs.end());
+    }
+    printTiming("capture.h x10000", packets, decodeNs);
+}
+
+void test_replay_file()
+{
+    const char *path = getenv("REPLAY_PCAP");
+    if (!path)
+    {
+        printf("REPLAY_PCAP not set, no capture to replay\n");
+        return;
+    }
+
+    FILE *file = fopen(path, "rb");
+    TEST_ASSERT_TRUE(file != nullptr);
+    std::vector<uint8_t> capture;
+    uint8_t chunk[4096];
+    size_t read;
+    while ((read = fread(chunk, 1, sizeof(chunk), file)) > 0)
+        capture.insert(capture.end(), chunk, chunk + read);
+    fclose(file);
+
+    // a board with every motor, shared stream frames are sliced from motor 0
+    static Replay replay;
+    const uint16_t groups[MOTORS] = {};
+    replay.receiver.configure(MOTORS, 0, groups);
+    TEST_ASSERT_TRUE(replayCapture(replay, capture.data(), capture.size()));
+    printReplay(path, replay);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_replay_fixture);
+    RUN_TEST(test_bench_replay);
+    RUN_TEST(test_replay_file);
+    return UNITY_END();
+}
@@ -0,0 +1,105 @@
+// Host tests for the motor frame sequence checks: pio test -e native -f test_sequence
+#include <unity.h>
+
+#include "software_defines.h"
+#include "frames/sequence.h"
+
+using namespace Haptics::Frames;
+
+void setUp() {}
+void tearDown() {}
+
+void test_first_frame_accepted()
+{
+    SequenceTracker tracker;
+    FrameStats stats = {};
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(5000, stats));
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(5001, stats));
+    TEST_ASSERT_EQUAL(0, stats.gaps);
+
+    // after a reset any number starts the session again
+    tracker.reset();
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(3, stats));
+    TEST_ASSERT_EQUAL(0, stats.droppedStale);
+}
+
+void test_duplicates_rejected()
+{
+    SequenceTracker tracker;
+    FrameStats stats = {};
+    tracker.check(10, stats);
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_DUPLICATE, tracker.check(10, stats));
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_DUPLICATE, tracker.check(10, stats));
+    TEST_ASSERT_EQUAL(2, stats.duplicates);
+    TEST_ASSERT_EQUAL(0, stats.droppedStale);
+}
+
+void test_gaps_count_lost_frames()
+{
+    SequenceTracker tracker;
+    FrameStats stats = {};
+    tracker.check(1, stats);
+    tracker.check(2, stats);
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(5, stats));
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(15, stats));
+    TEST_ASSERT_EQUAL(2, stats.gaps);
+    TEST_ASSERT_EQUAL(2 + 9, stats.lost);
+
+    // the frames that were lost turn up late, they are stale now
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_STALE, tracker.check(4, stats));
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_STALE, tracker.check(14, stats));
+    TEST_ASSERT_EQUAL(2, stats.droppedStale);
+    TEST_ASSERT_EQUAL(2 + 9, stats.lost);
+}
+
+void test_wraparound()
+{
+    SequenceTracker tracker;
+    FrameStats stats = {};
+    tracker.check(0xFFFFFFFE, stats);
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(0xFFFFFFFF, stats));
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(0, stats));
+    TEST_ASSERT_EQUAL(0, stats.gaps);
+
+    // a gap across the wrap is counted like any other
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(3, stats));
+    TEST_ASSERT_EQUAL(1, stats.gaps);
+    TEST_ASSERT_EQUAL(2, stats.lost);
+
+    // and the numbers from before it are behind
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_STALE, tracker.check(0xFFFFFFFF, stats));
+    TEST_ASSERT_EQUAL(1, stats.droppedStale);
+}
+
+void test_reset_window()
+{
+    SequenceTracker tracker;
+    FrameStats stats = {};
+    tracker.check(100000, stats);
+
+    // just inside the window is a late frame
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_STALE, tracker.check(100000 - (SEQUENCE_RESET_WINDOW - 1), stats));
+    TEST_ASSERT_EQUAL(1, stats.droppedStale);
+
+    // further back the host restarted its counter, it's accepted and becomes the new last number
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(100000 - SEQUENCE_RESET_WINDOW, stats));
+    TEST_ASSERT_EQUAL(0, stats.gaps);
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(100000 - SEQUENCE_RESET_WINDOW + 1, stats));
+
+    // a restart back to 0
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(0, stats));
+    TEST_ASSERT_EQUAL(SequenceTracker::SEQUENCE_ACCEPT, tracker.check(1, stats));
+    TEST_ASSERT_EQUAL(1, stats.droppedStale);
+    TEST_ASSERT_EQUAL(0, stats.lost);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_accepted);
+    RUN_TEST(test_duplicates_rejected);
+    RUN_TEST(test_gaps_count_lost_frames);
+    RUN_TEST(test_wraparound);
+    RUN_TEST(test_reset_window);
+    return UNITY_END();
+}
@@ -0,0 +1,206 @@
+// Host tests for serial framing and COBS decoding: pio test -e native -f test_serial
+#include <unity.h>
+#include <string.h>
+
+#include "software_defines.h"
+#include "frames/cobs.h"
+#include "frames/serial_framer.h"
+
+using namespace Haptics::Frames;
+
+void setUp() {}
+void tearDown() {}
+
+/// Reference encoder, delimiters not included.
+static size_t cobsEncode(const uint8_t *in, size_t len, uint8_t *out)
+{
+    size_t codeAt = 0;
+    size_t written = 1;
+    uint8_t code = 1;
+    for (size_t i = 0; i < len; i++)
+    {
+        if (in[i] == 0)
+        {
+            out[codeAt] = code;
+            codeAt = written++;
+            code = 1;
+            continue;
+        }
+        out[written++] = in[i];
+        if (++code == 0xff)
+        {
+            out[codeAt] = code;
+            codeAt = written++;
+            code = 1;
+        }
+    }
+    out[codeAt] = code;
+    return written;
+}
+
+/// Feeds bytes and counts each event, the last frame stays in the framer's buffer.
+struct Feed {
+    size_t events[SerialFramer::SERIAL_FRAME + 1] = {};
+
+    void push(SerialFramer &framer, const uint8_t *bytes, size_t len)
+    {
+        for (size_t i = 0; i < len; i++)
+            events[framer.push(bytes[i])]++;
+    }
+
+    void push(SerialFramer &framer, const char *text)
+    {
+        push(framer, (const uint8_t *)text, strlen(text));
+    }
+};
+
+void test_cobs_decodes_zero_runs()
+{
+    const uint8_t packet[] = {0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x22, 0x00};
+    uint8_t encoded[cobsMaxEncoded(sizeof(packet))];
+    const size_t len = cobsEncode(packet, sizeof(packet), encoded);
+    for (size_t i = 0; i < len; i++)
+        TEST_ASSERT_TRUE(encoded[i] != 0);
+
+    // in place, like the serial transport does
+    TEST_ASSERT_EQUAL(sizeof(packet), cobsDecode(encoded, len, encoded));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(packet, encoded, sizeof(packet));
+}
+
+void test_cobs_decodes_254_byte_block()
+{
+    // 254 non-zero bytes fill one 0xFF block, the next byte starts another
+    uint8_t packet[300];
+    for (size_t i = 0; i < sizeof(packet); i++)
+        packet[i] = (uint8_t)(i % 255 + 1);
+    uint8_t encoded[cobsMaxEncoded(sizeof(packet))];
+    const size_t len = cobsEncode(packet, sizeof(packet), encoded);
+    TEST_ASSERT_EQUAL(0xFF, encoded[0]);
+    TEST_ASSERT_EQUAL(sizeof(packet) + 2, len);
+
+    uint8_t out[sizeof(packet)];
+    TEST_ASSERT_EQUAL(sizeof(packet), cobsDecode(encoded, len, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(packet, out, sizeof(packet));
+
+    // exactly one block
+    TEST_ASSERT_EQUAL(254, cobsDecode(encoded, 255, out));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(packet, out, 254);
+}
+
+void test_cobs_rejects_truncated_frame()
+{
+    const uint8_t packet[] = {0x2F, 0x68, 0x00, 0x01, 0x02, 0x03};
+    uint8_t encoded[cobsMaxEncoded(sizeof(packet))];
+    const size_t len = cobsEncode(packet, sizeof(packet), encoded);
+    uint8_t out[sizeof(packet)];
+    // the last block's code points past the end
+    TEST_ASSERT_EQUAL(0, cobsDecode(encoded, len - 1, out));
+
+    // and a zero inside a block is never valid
+    encoded[1] = 0;
+    TEST_ASSERT_EQUAL(0, cobsDecode(encoded, len, out));
+    TEST_ASSERT_EQUAL(0, cobsDecode(encoded, 0, out));
+}
+
+void test_frame_after_command()
+{
+    uint8_t buffer[64];
+    SerialFramer framer(buffer, sizeof(buffer));
+    Feed feed;
+    framer.pause();
+    feed.push(framer, "GET STATS\r\n");
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_LINE_READY]);
+
+    const uint8_t packet[] = {0x2F, 0x68, 0x00, 0x00, 0x7F, 0x00};
+    uint8_t encoded[cobsMaxEncoded(sizeof(packet)) + 2];
+    encoded[0] = 0;
+    const size_t len = cobsEncode(packet, sizeof(packet), encoded + 1);
+    encoded[len + 1] = 0;
+    feed.push(framer, encoded, len + 2);
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_FRAME]);
+    TEST_ASSERT_EQUAL(sizeof(packet), framer.frameLength());
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(packet, buffer, sizeof(packet));
+
+    // a frame ends cleanly, the next command needs no pause
+    feed.push(framer, "PING\n");
+    TEST_ASSERT_EQUAL(2, feed.events[SerialFramer::SERIAL_LINE_READY]);
+    TEST_ASSERT_EQUAL(0, feed.events[SerialFramer::SERIAL_LINE_UNSYNCED]);
+}
+
+void test_oversized_frame_decodes_empty()
+{
+    uint8_t buffer[8];
+    SerialFramer framer(buffer, sizeof(buffer));
+    Feed feed;
+    uint8_t bytes[12];
+    memset(bytes, 0x05, sizeof(bytes));
+    bytes[0] = 0;
+    bytes[sizeof(bytes) - 1] = 0;
+    feed.push(framer, bytes, sizeof(bytes));
+    // still handed on, to be counted as malformed
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_FRAME]);
+    TEST_ASSERT_EQUAL(0, framer.frameLength());
+}
+
+void test_over_length_line_dropped()
+{
+    uint8_t buffer[8];
+    SerialFramer framer(buffer, sizeof(buffer));
+    Feed feed;
+    framer.pause();
+
+    static char longLine[SERIAL_LINE_MAX + 2];
+    memset(longLine, 'A', SERIAL_LINE_MAX);
+    longLine[SERIAL_LINE_MAX] = '\n';
+    longLine[SERIAL_LINE_MAX + 1] = 0;
+    feed.push(framer, longLine);
+    // exactly the limit still fits
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_LINE_READY]);
+
+    longLine[SERIAL_LINE_MAX] = 'A';
+    feed.push(framer, longLine);
+    feed.push(framer, "\n");
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_LINE_RESET]);
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_LINE_TOO_LONG]);
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_LINE_READY]);
+
+    // the next line is collected again
+    feed.push(framer, "PING\n");
+    TEST_ASSERT_EQUAL(2, feed.events[SerialFramer::SERIAL_LINE_READY]);
+}
+
+void test_mid_line_start_dropped()
+{
+    uint8_t buffer[8];
+    SerialFramer framer(buffer, sizeof(buffer));
+    Feed feed;
+    // joined halfway through a frame whose tail looks like text, a pause mid-line doesn't make it clean
+    feed.push(framer, "xy");
+    framer.pause();
+    feed.push(framer, "z\n");
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_LINE_UNSYNCED]);
+    TEST_ASSERT_EQUAL(0, feed.events[SerialFramer::SERIAL_LINE_READY]);
+
+    // empty lines are skipped, not submitted
+    feed.push(framer, "\r\n\n");
+    TEST_ASSERT_EQUAL(0, feed.events[SerialFramer::SERIAL_LINE_READY]);
+
+    // the newline resynchronized it
+    feed.push(framer, "PING\n");
+    TEST_ASSERT_EQUAL(1, feed.events[SerialFramer::SERIAL_LINE_READY]);
+    // the caller collected "xyz", "\r" and "PING"
+    TEST_ASSERT_EQUAL(8, feed.events[SerialFramer::SERIAL_LINE_CHAR]);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_cobs_decodes_zero_runs);
+    RUN_TEST(test_cobs_decodes_254_byte_block);
+    RUN_TEST(test_cobs_rejects_truncated_frame);
+    RUN_TEST(test_frame_after_command);
+    RUN_TEST(test_oversized_frame_decodes_empty);
+    RUN_TEST(test_over_length_line_dropped);
+    RUN_TEST(test_mid_line_start_dropped);
+    return UNITY_END();
+}
@@ -0,0 +1,101 @@
+// Host tests for the session table: pio test -e native -f test_sessions
+#include <unity.h>
+
+#include "software_defines.h"
+#include "frames/session_table.h"
+
+using namespace Haptics::Frames;
+
+static const uint32_t GAME = 0x0A01A8C0;    // 192.168.1.10
+static const uint32_t MONITOR = 0x0B01A8C0; // 192.168.1.11
+
+void setUp() {}
+void tearDown() {}
+
+void test_restart_from_new_port_replaces_session()
+{
+    SessionTable table;
+    Session previous;
+    table.open(GAME, 50000, 9000, 1000, previous);
+    TEST_ASSERT_FALSE(previous.active);
+    table.noteActivity(GAME, true, 2000);
+    TEST_ASSERT_EQUAL(GAME, table.motorSession()->ip);
+
+    // the game restarts and pings from a new ephemeral port before its old session timed out
+    Session *session = table.open(GAME, 50123, 9001, 3000, previous);
+    TEST_ASSERT_TRUE(previous.active);
+    TEST_ASSERT_EQUAL(50000, previous.sourcePort);
+
+    // its own dead session mustn't block the reset
+    TEST_ASSERT_FALSE(table.otherHostStreaming(GAME, 3000));
+
+    // one session for the address, replies go to the new port
+    size_t active = 0;
+    for (const Session &s : table)
+        active += s.active;
+    TEST_ASSERT_EQUAL(1, active);
+    TEST_ASSERT_TRUE(table.find(GAME) == session);
+    TEST_ASSERT_EQUAL(50123, session->sourcePort);
+    TEST_ASSERT_EQUAL(9001, session->port);
+
+    // not the motor host until the new socket sends frames
+    TEST_ASSERT_TRUE(table.motorSession() == nullptr);
+    table.noteActivity(GAME, true, 3100);
+    TEST_ASSERT_TRUE(table.motorSession() == session);
+}
+
+void test_other_address_blocks_reset()
+{
+    SessionTable table;
+    Session previous;
+    table.open(GAME, 50000, 9000, 1000, previous);
+    table.noteActivity(GAME, true, 2000);
+
+    table.open(MONITOR, 40000, 9100, 2500, previous);
+    TEST_ASSERT_TRUE(table.otherHostStreaming(MONITOR, 2500));
+    TEST_ASSERT_FALSE(table.otherHostStreaming(GAME, 2500));
+    TEST_ASSERT_EQUAL(GAME, table.motorSession()->ip);
+
+    // the game stops, after the timeout it no longer counts
+    TEST_ASSERT_FALSE(table.otherHostStreaming(MONITOR, 2000 + SESSION_TIMEOUT_MS));
+}
+
+void test_silent_sessions_expire()
+{
+    SessionTable table;
+    Session previous;
+    table.open(GAME, 50000, 9000, 1000, previous);
+    table.open(MONITOR, 40000, 9100, 1000, previous);
+    table.noteActivity(MONITOR, false, 30000);
+
+    table.expire(1000 + SESSION_TIMEOUT_MS);
+    TEST_ASSERT_TRUE(table.find(GAME) == nullptr);
+    TEST_ASSERT_TRUE(table.find(MONITOR) != nullptr);
+
+    // activity from a host that never pinged is ignored
+    table.noteActivity(GAME, true, 70000);
+    TEST_ASSERT_TRUE(table.motorSession() == nullptr);
+}
+
+void test_full_table_evicts_quietest()
+{
+    SessionTable table;
+    Session previous;
+    for (uint32_t i = 0; i < MAX_SESSIONS; i++)
+        table.open(GAME + (i << 24), 50000, 9000, 1000 + i, previous);
+
+    table.open(MONITOR + (0x20u << 24), 40000, 9100, 5000, previous);
+    TEST_ASSERT_TRUE(previous.active);
+    TEST_ASSERT_EQUAL(GAME, previous.ip);
+    TEST_ASSERT_TRUE(table.find(GAME) == nullptr);
+}
+
+int main()
+{
+    UNITY_BEGIN();
+    RUN_TEST(test_restart_from_new_port_replaces_session);
+    RUN_TEST(test_other_address_blocks_reset);
+    RUN_TEST(test_silent_sessions_expire);
+    RUN_TEST(test_full_table_evicts_quietest);
+    return UNITY_END();
+}